@@ -12,6 +12,8 @@
 #include "src/kernel/scheduler.h"
 #include "src/hal/hal.h"
 #include "src/utils/logger.h"
+#include "src/utils/trace.h"
+#include "src/utils/flight_recorder.h"
 #include "src/app/tasks.h"
 #include "simulator/virt_board.h"
 
@@ -43,6 +45,9 @@ int main() {
     signal(SIGINT, signal_handler);
     
     logger_init(LOG_LEVEL_INFO);
+    logger_async_start();
+    trace_enable(TRACE_CAT_ALL);
+    flight_recorder_install("flight_recorder.log");
     LOG_INFO("System initialization started...");
     
     virt_board_init();
@@ -60,6 +65,8 @@ int main() {
     printf("  [s] - Show task statistics\n");
     printf("  [u] - Simulate OTA update\n");
     printf("  [d] - Display dashboard\n");
+    printf("  [t] - Dump recent trace points\n");
+    printf("  [f] - Write flight recorder to flight_recorder.log\n");
     printf("  [q] - Quit program\n");
     printf("  [Ctrl+C] - Emergency shutdown\n\n");
     printf("System is now running...\n\n");
@@ -67,9 +74,12 @@ int main() {
     uint32_t last_stat_print = 0;
     uint32_t dashboard_counter = 0;
     
+    flight_recorder_watchdog_start(5000, NULL);
+    
     while (running && virt_board_is_running()) {
         scheduler_tick();
         virt_board_update();
+        flight_recorder_watchdog_kick();
         
         uint32_t ticks = scheduler_get_tick_count();
         
@@ -113,6 +123,16 @@ int main() {
                     printf("================================\n\n");
                     break;
                     
+                case 't':
+                case 'T':
+                    trace_dump(stdout, TRACE_CAT_ALL);
+                    break;
+                    
+                case 'f':
+                case 'F':
+                    flight_recorder_dump("flight_recorder.log", "user request");
+                    break;
+                    
                 case 'q':
                 case 'Q':
                     running = 0;
@@ -131,7 +151,9 @@ int main() {
         sleep_ms(1);
     }
     
+    flight_recorder_watchdog_stop();
     LOG_INFO("System shutdown initiated...");
+    logger_async_stop();
     printf("\n=== FINAL STATISTICS ===\n");
     scheduler_task_stats();
     virt_board_shutdown();
@@ -1,4 +1,5 @@
 #include "virt_board.h"
+#include "../src/utils/trace.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -169,7 +170,7 @@ void virt_board_tick(void) {
     for (int i = 0; i < 32; i++) {
         if (interrupts[i].enabled && interrupts[i].pending) {
             if (interrupts[i].handler) {
-                printf("[VIRT_BOARD] Handling interrupt %u\n", i);
+                TRACE(TRACE_CAT_IRQ, "Handling interrupt %u", i);
                 interrupts[i].handler();
                 interrupts[i].pending = false;
             }
@@ -0,0 +1,279 @@
+#include "ahrs.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// ==================== HELPERS ====================
+float ahrs_inv_sqrt(float x) {
+#if AHRS_FAST_INV_SQRT
+    // Magic-constant estimate, then one Newton step with coefficients
+    // tuned for the smallest maximum error (about 6.5e-4)
+    union { float f; uint32_t i; } bits = { .f = x };
+    bits.i = 0x5F1FFFF9u - (bits.i >> 1);
+    float y = bits.f;
+    return y * 0.703952253f * (2.38924456f - x * y * y);
+#else
+    return 1.0f / sqrtf(x);
+#endif
+}
+
+static void ahrs_normalize_quaternion(float q[4]) {
+    float recip_norm = ahrs_inv_sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    q[0] *= recip_norm;
+    q[1] *= recip_norm;
+    q[2] *= recip_norm;
+    q[3] *= recip_norm;
+}
+
+// ==================== LIFECYCLE ====================
+void ahrs_init_madgwick(ahrs_t* ahrs, float sample_period, float beta) {
+    if (!ahrs) return;
+    
+    memset(ahrs, 0, sizeof(*ahrs));
+    ahrs->algorithm = AHRS_MADGWICK;
+    ahrs->sample_period = sample_period;
+    ahrs->beta = beta;
+    ahrs->q[0] = 1.0f;
+    
+    printf("[AHRS] Madgwick initialized: period=%.4f s, beta=%.3f\n", sample_period, beta);
+}
+
+void ahrs_init_mahony(ahrs_t* ahrs, float sample_period, float kp, float ki) {
+    if (!ahrs) return;
+    
+    memset(ahrs, 0, sizeof(*ahrs));
+    ahrs->algorithm = AHRS_MAHONY;
+    ahrs->sample_period = sample_period;
+    ahrs->kp = kp;
+    ahrs->ki = ki;
+    ahrs->q[0] = 1.0f;
+    
+    printf("[AHRS] Mahony initialized: period=%.4f s, kp=%.3f, ki=%.3f\n", sample_period, kp, ki);
+}
+
+void ahrs_reset(ahrs_t* ahrs) {
+    if (!ahrs) return;
+    
+    ahrs->q[0] = 1.0f;
+    ahrs->q[1] = ahrs->q[2] = ahrs->q[3] = 0.0f;
+    ahrs->integral[0] = ahrs->integral[1] = ahrs->integral[2] = 0.0f;
+}
+
+// ==================== MADGWICK ====================
+// Gradient descent step towards the orientation that maps gravity (and
+// the earth field) onto the measurements, blended with gyro integration
+static void madgwick_step(ahrs_t* ahrs, const ahrs_sample_t* s) {
+    float* q = ahrs->q;
+    float q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    float gx = s->gx, gy = s->gy, gz = s->gz;
+    float ax = s->ax, ay = s->ay, az = s->az;
+    float mx = s->mx, my = s->my, mz = s->mz;
+    
+    // Rate of change of quaternion from gyroscope
+    float qdot0 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+    float qdot1 = 0.5f * (q0 * gx + q2 * gz - q3 * gy);
+    float qdot2 = 0.5f * (q0 * gy - q1 * gz + q3 * gx);
+    float qdot3 = 0.5f * (q0 * gz + q1 * gy - q2 * gx);
+    
+    // Corrective step only with a valid accelerometer reading
+    if (!(ax == 0.0f && ay == 0.0f && az == 0.0f)) {
+        float recip_norm = ahrs_inv_sqrt(ax * ax + ay * ay + az * az);
+        ax *= recip_norm;
+        ay *= recip_norm;
+        az *= recip_norm;
+        
+        float s0, s1, s2, s3;
+        float _2q0 = 2.0f * q0, _2q1 = 2.0f * q1, _2q2 = 2.0f * q2, _2q3 = 2.0f * q3;
+        float q0q0 = q0 * q0, q1q1 = q1 * q1, q2q2 = q2 * q2, q3q3 = q3 * q3;
+        
+        if (mx == 0.0f && my == 0.0f && mz == 0.0f) {
+            // 6-DoF: gravity only
+            float _4q0 = 4.0f * q0, _4q1 = 4.0f * q1, _4q2 = 4.0f * q2;
+            float _8q1 = 8.0f * q1, _8q2 = 8.0f * q2;
+            
+            s0 = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+            s1 = _4q1 * q3q3 - _2q3 * ax + 4.0f * q0q0 * q1 - _2q0 * ay - _4q1 + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+            s2 = 4.0f * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+            s3 = 4.0f * q1q1 * q3 - _2q1 * ax + 4.0f * q2q2 * q3 - _2q2 * ay;
+        } else {
+            // 9-DoF: gravity and the earth field, reduced to [bx, 0, bz]
+            recip_norm = ahrs_inv_sqrt(mx * mx + my * my + mz * mz);
+            mx *= recip_norm;
+            my *= recip_norm;
+            mz *= recip_norm;
+            
+            float _2q0mx = 2.0f * q0 * mx, _2q0my = 2.0f * q0 * my, _2q0mz = 2.0f * q0 * mz;
+            float _2q1mx = 2.0f * q1 * mx;
+            float _2q0q2 = 2.0f * q0 * q2, _2q2q3 = 2.0f * q2 * q3;
+            float q0q1 = q0 * q1, q0q2 = q0 * q2, q0q3 = q0 * q3;
+            float q1q2 = q1 * q2, q1q3 = q1 * q3, q2q3 = q2 * q3;
+            
+            // Reference direction of the earth field
+            float hx = mx * q0q0 - _2q0my * q3 + _2q0mz * q2 + mx * q1q1 + _2q1 * my * q2 +
+                       _2q1 * mz * q3 - mx * q2q2 - mx * q3q3;
+            float hy = _2q0mx * q3 + my * q0q0 - _2q0mz * q1 + _2q1mx * q2 - my * q1q1 +
+                       my * q2q2 + _2q2 * mz * q3 - my * q3q3;
+            float _2bx = sqrtf(hx * hx + hy * hy);
+            float _2bz = -_2q0mx * q2 + _2q0my * q1 + mz * q0q0 + _2q1mx * q3 - mz * q1q1 +
+                         _2q2 * my * q3 - mz * q2q2 + mz * q3q3;
+            float _4bx = 2.0f * _2bx, _4bz = 2.0f * _2bz;
+            
+            // Objective function terms shared by the gradient
+            float fax = 2.0f * q1q3 - _2q0q2 - ax;
+            float fay = 2.0f * q0q1 + _2q2q3 - ay;
+            float faz = 1.0f - 2.0f * q1q1 - 2.0f * q2q2 - az;
+            float fmx = _2bx * (0.5f - q2q2 - q3q3) + _2bz * (q1q3 - q0q2) - mx;
+            float fmy = _2bx * (q1q2 - q0q3) + _2bz * (q0q1 + q2q3) - my;
+            float fmz = _2bx * (q0q2 + q1q3) + _2bz * (0.5f - q1q1 - q2q2) - mz;
+            
+            s0 = -_2q2 * fax + _2q1 * fay - _2bz * q2 * fmx + (-_2bx * q3 + _2bz * q1) * fmy +
+                 _2bx * q2 * fmz;
+            s1 = _2q3 * fax + _2q0 * fay - 4.0f * q1 * faz + _2bz * q3 * fmx +
+                 (_2bx * q2 + _2bz * q0) * fmy + (_2bx * q3 - _4bz * q1) * fmz;
+            s2 = -_2q0 * fax + _2q3 * fay - 4.0f * q2 * faz + (-_4bx * q2 - _2bz * q0) * fmx +
+                 (_2bx * q1 + _2bz * q3) * fmy + (_2bx * q0 - _4bz * q2) * fmz;
+            s3 = _2q1 * fax + _2q2 * fay + (-_4bx * q3 + _2bz * q1) * fmx +
+                 (-_2bx * q0 + _2bz * q2) * fmy + _2bx * q1 * fmz;
+        }
+        
+        // Normalise the step, then apply feedback
+        float step = s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3;
+        if (step > 0.0f) {
+            recip_norm = ahrs->beta * ahrs_inv_sqrt(step);
+            qdot0 -= recip_norm * s0;
+            qdot1 -= recip_norm * s1;
+            qdot2 -= recip_norm * s2;
+            qdot3 -= recip_norm * s3;
+        }
+    }
+    
+    // Integrate rate of change of quaternion
+    float dt = ahrs->sample_period;
+    q[0] = q0 + qdot0 * dt;
+    q[1] = q1 + qdot1 * dt;
+    q[2] = q2 + qdot2 * dt;
+    q[3] = q3 + qdot3 * dt;
+    ahrs_normalize_quaternion(q);
+}
+
+// ==================== MAHONY ====================
+// Cross product of measured and estimated directions drives a PI
+// correction of the gyro rates; the integral term tracks gyro bias
+static void mahony_step(ahrs_t* ahrs, const ahrs_sample_t* s) {
+    float* q = ahrs->q;
+    float q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    float gx = s->gx, gy = s->gy, gz = s->gz;
+    float ax = s->ax, ay = s->ay, az = s->az;
+    float mx = s->mx, my = s->my, mz = s->mz;
+    float dt = ahrs->sample_period;
+    
+    // Corrective feedback only with a valid accelerometer reading
+    if (!(ax == 0.0f && ay == 0.0f && az == 0.0f)) {
+        float recip_norm = ahrs_inv_sqrt(ax * ax + ay * ay + az * az);
+        ax *= recip_norm;
+        ay *= recip_norm;
+        az *= recip_norm;
+        
+        float q0q1 = q0 * q1, q0q2 = q0 * q2, q0q3 = q0 * q3;
+        float q1q1 = q1 * q1, q1q2 = q1 * q2, q1q3 = q1 * q3;
+        float q2q2 = q2 * q2, q2q3 = q2 * q3, q3q3 = q3 * q3;
+        
+        // Estimated direction of gravity (halved)
+        float halfvx = q1q3 - q0q2;
+        float halfvy = q0q1 + q2q3;
+        float halfvz = q0 * q0 - 0.5f + q3q3;
+        
+        // Error is the cross product of measured and estimated directions
+        float halfex = ay * halfvz - az * halfvy;
+        float halfey = az * halfvx - ax * halfvz;
+        float halfez = ax * halfvy - ay * halfvx;
+        
+        if (!(mx == 0.0f && my == 0.0f && mz == 0.0f)) {
+            recip_norm = ahrs_inv_sqrt(mx * mx + my * my + mz * mz);
+            mx *= recip_norm;
+            my *= recip_norm;
+            mz *= recip_norm;
+            
+            // Earth field reduced to [bx, 0, bz], then its estimated direction
+            float hx = 2.0f * (mx * (0.5f - q2q2 - q3q3) + my * (q1q2 - q0q3) + mz * (q1q3 + q0q2));
+            float hy = 2.0f * (mx * (q1q2 + q0q3) + my * (0.5f - q1q1 - q3q3) + mz * (q2q3 - q0q1));
+            float bx = sqrtf(hx * hx + hy * hy);
+            float bz = 2.0f * (mx * (q1q3 - q0q2) + my * (q2q3 + q0q1) + mz * (0.5f - q1q1 - q2q2));
+            
+            float halfwx = bx * (0.5f - q2q2 - q3q3) + bz * (q1q3 - q0q2);
+            float halfwy = bx * (q1q2 - q0q3) + bz * (q0q1 + q2q3);
+            float halfwz = bx * (q0q2 + q1q3) + bz * (0.5f - q1q1 - q2q2);
+            
+            halfex += my * halfwz - mz * halfwy;
+            halfey += mz * halfwx - mx * halfwz;
+            halfez += mx * halfwy - my * halfwx;
+        }
+        
+        // Integral feedback, then proportional feedback
+        if (ahrs->ki > 0.0f) {
+            float gain = 2.0f * ahrs->ki * dt;
+            ahrs->integral[0] += gain * halfex;
+            ahrs->integral[1] += gain * halfey;
+            ahrs->integral[2] += gain * halfez;
+            gx += ahrs->integral[0];
+            gy += ahrs->integral[1];
+            gz += ahrs->integral[2];
+        } else {
+            ahrs->integral[0] = ahrs->integral[1] = ahrs->integral[2] = 0.0f;
+        }
+        
+        float two_kp = 2.0f * ahrs->kp;
+        gx += two_kp * halfex;
+        gy += two_kp * halfey;
+        gz += two_kp * halfez;
+    }
+    
+    // Integrate rate of change of quaternion
+    gx *= 0.5f * dt;
+    gy *= 0.5f * dt;
+    gz *= 0.5f * dt;
+    q[0] = q0 + (-q1 * gx - q2 * gy - q3 * gz);
+    q[1] = q1 + (q0 * gx + q2 * gz - q3 * gy);
+    q[2] = q2 + (q0 * gy - q1 * gz + q3 * gx);
+    q[3] = q3 + (q0 * gz + q1 * gy - q2 * gx);
+    ahrs_normalize_quaternion(q);
+}
+
+// ==================== UPDATE ====================
+void ahrs_update(ahrs_t* ahrs, const ahrs_sample_t* sample) {
+    if (!ahrs || !sample) return;
+    
+    if (ahrs->algorithm == AHRS_MADGWICK) {
+        madgwick_step(ahrs, sample);
+    } else {
+        mahony_step(ahrs, sample);
+    }
+}
+
+void ahrs_update_batch(ahrs_t* ahrs, const ahrs_sample_t* samples, uint32_t count) {
+    if (!ahrs || !samples) return;
+    
+    // One dispatch per block; the step functions inline into the loops
+    if (ahrs->algorithm == AHRS_MADGWICK) {
+        for (uint32_t i = 0; i < count; i++) {
+            madgwick_step(ahrs, &samples[i]);
+        }
+    } else {
+        for (uint32_t i = 0; i < count; i++) {
+            mahony_step(ahrs, &samples[i]);
+        }
+    }
+}
+
+void ahrs_get_euler(const ahrs_t* ahrs, float* roll, float* pitch, float* yaw) {
+    if (!ahrs) return;
+    
+    const float* q = ahrs->q;
+    float sin_pitch = 2.0f * (q[0] * q[2] - q[3] * q[1]);
+    if (sin_pitch > 1.0f) sin_pitch = 1.0f;
+    if (sin_pitch < -1.0f) sin_pitch = -1.0f;
+    
+    if (roll) *roll = atan2f(2.0f * (q[0] * q[1] + q[2] * q[3]), 1.0f - 2.0f * (q[1] * q[1] + q[2] * q[2]));
+    if (pitch) *pitch = asinf(sin_pitch);
+    if (yaw) *yaw = atan2f(2.0f * (q[0] * q[3] + q[1] * q[2]), 1.0f - 2.0f * (q[2] * q[2] + q[3] * q[3]));
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef AHRS_H
+#define AHRS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Orientation fusion (AHRS) for 6-DoF and 9-DoF IMUs. The orientation is a
+// unit quaternion [w, x, y, z] that rotates sensor-frame vectors into the
+// earth frame, with z up. Each instance owns its state.
+
+// Normalisations use a bit-level inverse square root with one tuned
+// Newton step (relative error < 1e-3). Set to 0 to use 1.0f / sqrtf().
+#ifndef AHRS_FAST_INV_SQRT
+#define AHRS_FAST_INV_SQRT      1
+#endif
+
+typedef enum {
+    AHRS_MADGWICK = 0,          // Gradient descent, one gain (beta)
+    AHRS_MAHONY                 // Complementary PI feedback (kp, ki)
+} ahrs_algorithm_t;
+
+// One IMU reading
+typedef struct {
+    float gx, gy, gz;           // Angular rate, rad/s
+    float ax, ay, az;           // Acceleration, any unit (normalized)
+    float mx, my, mz;           // Magnetic field, any unit; all zero = 6-DoF
+} ahrs_sample_t;
+
+typedef struct {
+    ahrs_algorithm_t algorithm;
+    float q[4];                 // Orientation [w, x, y, z]
+    float sample_period;        // Seconds between samples
+    float beta;                 // Madgwick gain
+    float kp;                   // Mahony proportional gain
+    float ki;                   // Mahony integral gain
+    float integral[3];          // Mahony integral feedback (gyro bias)
+} ahrs_t;
+
+void ahrs_init_madgwick(ahrs_t* ahrs, float sample_period, float beta);
+void ahrs_init_mahony(ahrs_t* ahrs, float sample_period, float kp, float ki);
+
+// Back to the identity orientation (gains kept)
+void ahrs_reset(ahrs_t* ahrs);
+
+// Fuse one reading
+void ahrs_update(ahrs_t* ahrs, const ahrs_sample_t* sample);
+
+// Fuse 'count' consecutive readings taken sample_period apart
+void ahrs_update_batch(ahrs_t* ahrs, const ahrs_sample_t* samples, uint32_t count);
+
+// Orientation as roll (x), pitch (y), yaw (z) in radians
+void ahrs_get_euler(const ahrs_t* ahrs, float* roll, float* pitch, float* yaw);
+
+// 1 / sqrt(x) for x > 0, as used by the filters
+float ahrs_inv_sqrt(float x);
+
+#endif
\ No newline at end of file
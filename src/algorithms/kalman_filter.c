@@ -1,8 +1,17 @@
 #include "kalman_filter.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
+// Vector width for kalman1d_update_batch(), chosen at compile time:
+// 8 lanes with -mavx / -mavx2, 4 with SSE (any x86-64), else scalar
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 // ==================== 1D KALMAN FILTER ====================
 void kalman1d_init(kalman1d_t* kf, float q, float r, float initial_value, float initial_error) {
     if (!kf) return;
@@ -13,6 +22,7 @@ void kalman1d_init(kalman1d_t* kf, float q, float r, float initial_value, float
     kf->p = initial_error;
     kf->k = 0.0f;
     kf->last_update = 0.0f;
+    kf->steady = false;
     
     printf("[KALMAN1D] Initialized: q=%.6f, r=%.6f, x0=%.3f, p0=%.3f\n",
            q, r, initial_value, initial_error);
@@ -21,14 +31,25 @@ void kalman1d_init(kalman1d_t* kf, float q, float r, float initial_value, float
 float kalman1d_update(kalman1d_t* kf, float measurement) {
     if (!kf) return measurement;
     
+    // Converged: k and p are fixed, only the state moves
+    if (kf->steady && kf->q == kf->steady_q && kf->r == kf->steady_r) {
+        kf->x = kf->x + kf->k * (measurement - kf->x);
+        return kf->x;
+    }
+    
     // Prediction update
     kf->p = kf->p + kf->q;
     
     // Measurement update
+    float previous_k = kf->k;
     kf->k = kf->p / (kf->p + kf->r);
     kf->x = kf->x + kf->k * (measurement - kf->x);
     kf->p = (1.0f - kf->k) * kf->p;
     
+    kf->steady = fabsf(kf->k - previous_k) <= KALMAN_STEADY_TOLERANCE * kf->k;
+    kf->steady_q = kf->q;
+    kf->steady_r = kf->r;
+    
     return kf->x;
 }
 
@@ -37,6 +58,7 @@ void kalman1d_reset(kalman1d_t* kf, float new_value) {
     
     kf->x = new_value;
     kf->p = 1.0f; // Reset error covariance
+    kf->steady = false;
     printf("[KALMAN1D] Reset to value: %.3f\n", new_value);
 }
 
@@ -48,6 +70,101 @@ float kalman1d_predict(kalman1d_t* kf, float dt) {
     return kf->x;
 }
 
+// ==================== 1D KALMAN FILTER BANK ====================
+bool kalman1d_bank_init(kalman1d_bank_t* bank, uint32_t channels) {
+    if (!bank || channels == 0) return false;
+    
+    // One block for all five arrays
+    float* block = (float*)calloc((size_t)channels * 5, sizeof(float));
+    if (!block) {
+        printf("[KALMAN1D] Error: Cannot allocate bank of %u channels\n", channels);
+        return false;
+    }
+    
+    bank->q = block;
+    bank->r = block + channels;
+    bank->x = block + channels * 2;
+    bank->p = block + channels * 3;
+    bank->k = block + channels * 4;
+    bank->count = channels;
+    
+    printf("[KALMAN1D] Bank initialized: %u channels\n", channels);
+    return true;
+}
+
+void kalman1d_bank_destroy(kalman1d_bank_t* bank) {
+    if (!bank) return;
+    
+    free(bank->q);
+    memset(bank, 0, sizeof(*bank));
+}
+
+void kalman1d_bank_set_channel(kalman1d_bank_t* bank, uint32_t channel, float q, float r,
+                               float initial_value, float initial_error) {
+    if (!bank || channel >= bank->count) return;
+    
+    bank->q[channel] = q;
+    bank->r[channel] = r;
+    bank->x[channel] = initial_value;
+    bank->p[channel] = initial_error;
+    bank->k[channel] = 0.0f;
+}
+
+void kalman1d_update_batch(kalman1d_bank_t* bank, const float* measurements, float* estimates) {
+    if (!bank || !measurements) return;
+    
+    float* q = bank->q;
+    float* r = bank->r;
+    float* x = bank->x;
+    float* p = bank->p;
+    float* k = bank->k;
+    uint32_t count = bank->count;
+    uint32_t i = 0;
+    
+    // Same operations, in the same order, as kalman1d_update()
+#if defined(__AVX__)
+    const __m256 one = _mm256_set1_ps(1.0f);
+    for (; i + 8 <= count; i += 8) {
+        __m256 pv = _mm256_add_ps(_mm256_loadu_ps(p + i), _mm256_loadu_ps(q + i));
+        __m256 kv = _mm256_div_ps(pv, _mm256_add_ps(pv, _mm256_loadu_ps(r + i)));
+        __m256 xv = _mm256_loadu_ps(x + i);
+        xv = _mm256_add_ps(xv, _mm256_mul_ps(kv, _mm256_sub_ps(_mm256_loadu_ps(measurements + i), xv)));
+        pv = _mm256_mul_ps(_mm256_sub_ps(one, kv), pv);
+        
+        _mm256_storeu_ps(p + i, pv);
+        _mm256_storeu_ps(k + i, kv);
+        _mm256_storeu_ps(x + i, xv);
+        if (estimates) _mm256_storeu_ps(estimates + i, xv);
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        __m128 pv = _mm_add_ps(_mm_loadu_ps(p + i), _mm_loadu_ps(q + i));
+        __m128 kv = _mm_div_ps(pv, _mm_add_ps(pv, _mm_loadu_ps(r + i)));
+        __m128 xv = _mm_loadu_ps(x + i);
+        xv = _mm_add_ps(xv, _mm_mul_ps(kv, _mm_sub_ps(_mm_loadu_ps(measurements + i), xv)));
+        pv = _mm_mul_ps(_mm_sub_ps(one, kv), pv);
+        
+        _mm_storeu_ps(p + i, pv);
+        _mm_storeu_ps(k + i, kv);
+        _mm_storeu_ps(x + i, xv);
+        if (estimates) _mm_storeu_ps(estimates + i, xv);
+    }
+#endif
+
+    // Remaining channels (all of them without SIMD)
+    for (; i < count; i++) {
+        float pi = p[i] + q[i];
+        float ki = pi / (pi + r[i]);
+        float xi = x[i] + ki * (measurements[i] - x[i]);
+        
+        p[i] = (1.0f - ki) * pi;
+        k[i] = ki;
+        x[i] = xi;
+        if (estimates) estimates[i] = xi;
+    }
+}
+
 // ==================== 2D KALMAN FILTER ====================
 void kalman2d_init(kalman2d_t* kf, float process_noise, float measurement_noise, 
                    float initial_pos, float initial_vel, float dt) {
@@ -82,15 +199,31 @@ void kalman2d_init(kalman2d_t* kf, float process_noise, float measurement_noise,
     kf->H[0] = 1.0f;
     kf->H[1] = 0.0f;
     
+    kf->K[0] = 0.0f;
+    kf->K[1] = 0.0f;
     kf->last_update = 0.0f;
+    kf->steady = false;
     
     printf("[KALMAN2D] Initialized: pos0=%.3f, vel0=%.3f, dt=%.3f\n",
            initial_pos, initial_vel, dt);
 }
 
+// Element-wise equality of two 2x2 matrices
+static bool kalman2d_same(const float a[2][2], const float b[2][2]) {
+    return a[0][0] == b[0][0] && a[0][1] == b[0][1] &&
+           a[1][0] == b[1][0] && a[1][1] == b[1][1];
+}
+
 void kalman2d_predict(kalman2d_t* kf, float dt) {
     if (!kf) return;
     
+    // The fast path also needs P where the last update left it
+    if (kf->steady && (dt != kf->steady_dt ||
+                       !kalman2d_same(kf->Q, kf->steady_Q) ||
+                       !kalman2d_same(kf->P, kf->steady_P_post))) {
+        kf->steady = false;
+    }
+    
     // Update state transition matrix with new dt
     kf->F[0][1] = dt;
     
@@ -101,6 +234,12 @@ void kalman2d_predict(kalman2d_t* kf, float dt) {
     kf->x[0] = new_x0;
     kf->x[1] = new_x1;
     
+    // Converged: the predicted covariance is the same every cycle
+    if (kf->steady) {
+        memcpy(kf->P, kf->steady_P_prior, sizeof(kf->P));
+        return;
+    }
+    
     // Covariance prediction: P = F * P * F^T + Q
     float P00 = kf->P[0][0];
     float P01 = kf->P[0][1];
@@ -126,6 +265,18 @@ void kalman2d_update(kalman2d_t* kf, float measurement) {
     // Innovation: y = z - H * x
     float y = measurement - (kf->H[0] * kf->x[0] + kf->H[1] * kf->x[1]);
     
+    // Converged: fixed gain, the updated covariance is the same every cycle
+    if (kf->steady && kf->R == kf->steady_R && kalman2d_same(kf->P, kf->steady_P_prior)) {
+        kf->x[0] = kf->x[0] + kf->K[0] * y;
+        kf->x[1] = kf->x[1] + kf->K[1] * y;
+        memcpy(kf->P, kf->steady_P_post, sizeof(kf->P));
+        return;
+    }
+    kf->steady = false;
+    
+    float previous_K0 = kf->K[0];
+    float previous_K1 = kf->K[1];
+    
     // Innovation covariance: S = H * P * H^T + R
     float S = kf->H[0] * (kf->P[0][0] * kf->H[0] + kf->P[0][1] * kf->H[1]) +
               kf->H[1] * (kf->P[1][0] * kf->H[0] + kf->P[1][1] * kf->H[1]) + kf->R;
@@ -154,6 +305,20 @@ void kalman2d_update(kalman2d_t* kf, float measurement) {
     kf->P[0][1] = (1.0f - KH00) * P01 - KH01 * P11;
     kf->P[1][0] = -KH10 * P00 + (1.0f - KH11) * P10;
     kf->P[1][1] = -KH10 * P01 + (1.0f - KH11) * P11;
+    
+    // Gain settled: remember both covariances for the fast path
+    if (fabsf(kf->K[0] - previous_K0) <= KALMAN_STEADY_TOLERANCE * fabsf(kf->K[0]) &&
+        fabsf(kf->K[1] - previous_K1) <= KALMAN_STEADY_TOLERANCE * fabsf(kf->K[1])) {
+        kf->steady = true;
+        kf->steady_R = kf->R;
+        kf->steady_dt = kf->F[0][1];
+        memcpy(kf->steady_Q, kf->Q, sizeof(kf->Q));
+        kf->steady_P_prior[0][0] = P00;
+        kf->steady_P_prior[0][1] = P01;
+        kf->steady_P_prior[1][0] = P10;
+        kf->steady_P_prior[1][1] = P11;
+        memcpy(kf->steady_P_post, kf->P, sizeof(kf->P));
+    }
 }
 
 float kalman2d_get_position(kalman2d_t* kf) {
@@ -165,6 +330,8 @@ float kalman2d_get_velocity(kalman2d_t* kf) {
 }
 
 // ==================== FILTER HELPER FUNCTIONS ====================
+// Keeps its angle in a static, so it covers one axis for one caller; see
+// ahrs.h for quaternion fusion of a full IMU
 float complementary_filter(float accel, float gyro, float dt, float alpha) {
     // Complementary filter combines accelerometer and gyroscope data
     // alpha determines the weight given to each sensor
@@ -179,6 +346,8 @@ float complementary_filter(float accel, float gyro, float dt, float alpha) {
     return angle;
 }
 
+// Keeps its window in statics, so only one caller may use it; see
+// window_stats.h for per-channel windows
 float moving_average(float* buffer, uint32_t size, float new_value) {
     static uint32_t index = 0;
     static uint32_t count = 0;
@@ -214,13 +383,18 @@ float high_pass_filter(float input, float prev_input, float prev_output, float a
     return alpha * (prev_output + input - prev_input);
 }
 
-// ==================== 3D KALMAN FILTER (SIMPLIFIED) ====================
+// ==================== 3D KALMAN FILTER ====================
+// Constant velocity model, state [x, y, z, vx, vy, vz], positions measured.
+// F = [I dt*I; 0 I] and H = [I 0] are fixed, so the kernels below are
+// written for them instead of going through generic 6x6 products. P is
+// symmetric: only its upper triangle is computed, then mirrored.
 void kalman3d_init_simple(kalman3d_t* kf, float pos_noise, float vel_noise, 
                           float measurement_noise, float dt) {
     if (!kf) return;
     
     // Initialize state vector to zeros
     memset(kf->x, 0, sizeof(kf->x));
+    memset(kf->K, 0, sizeof(kf->K));
     
     // Initialize covariance matrix as identity
     for (int i = 0; i < 6; i++) {
@@ -250,8 +424,125 @@ void kalman3d_init_simple(kalman3d_t* kf, float pos_noise, float vel_noise,
         }
     }
     
+    // State transition and measurement matrices (kept for reference;
+    // predict / update use their fixed structure directly)
+    memset(kf->F, 0, sizeof(kf->F));
+    memset(kf->H, 0, sizeof(kf->H));
+    for (int i = 0; i < 6; i++) {
+        kf->F[i][i] = 1.0f;
+    }
+    for (int i = 0; i < 3; i++) {
+        kf->F[i][i + 3] = dt;
+        kf->H[i][i] = 1.0f;
+    }
+    
+    kf->last_update = 0.0f;
+    
     printf("[KALMAN3D] Simplified initialization complete\n");
 }
 
-// Note: Full 3D Kalman implementation is complex and beyond this example's scope
-// This provides the structure for a complete implementation
\ No newline at end of file
+void kalman3d_predict(kalman3d_t* kf, float dt) {
+    if (!kf) return;
+    
+    // State prediction: position += velocity * dt
+    for (int i = 0; i < 3; i++) {
+        kf->F[i][i + 3] = dt;
+        kf->x[i] += dt * kf->x[i + 3];
+    }
+    
+    // Covariance prediction with P = [A B; B^T C] in 3x3 blocks:
+    // A' = A + dt * (B + B^T) + dt^2 * C, B' = B + dt * C, C' = C.
+    // A' reads the old B, so it goes first.
+    float (*P)[6] = kf->P;
+    float dt2 = dt * dt;
+    
+    for (int i = 0; i < 3; i++) {
+        for (int j = i; j < 3; j++) {
+            P[i][j] += dt * (P[i][j + 3] + P[j][i + 3]) + dt2 * P[i + 3][j + 3];
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        P[i][3] += dt * P[i + 3][3];
+        P[i][4] += dt * P[i + 3][4];
+        P[i][5] += dt * P[i + 3][5];
+    }
+    
+    // + Q, then mirror the upper triangle
+    for (int i = 0; i < 6; i++) {
+        for (int j = i; j < 6; j++) {
+            P[i][j] += kf->Q[i][j];
+            P[j][i] = P[i][j];
+        }
+    }
+}
+
+void kalman3d_update(kalman3d_t* kf, float x, float y, float z) {
+    if (!kf) return;
+    
+    float (*P)[6] = kf->P;
+    
+    // Innovation: y = z - H * x
+    float y0 = x - kf->x[0];
+    float y1 = y - kf->x[1];
+    float y2 = z - kf->x[2];
+    
+    // Innovation covariance: S = H * P * H^T + R = A + R (symmetric)
+    float s00 = P[0][0] + kf->R[0][0];
+    float s01 = P[0][1] + kf->R[0][1];
+    float s02 = P[0][2] + kf->R[0][2];
+    float s11 = P[1][1] + kf->R[1][1];
+    float s12 = P[1][2] + kf->R[1][2];
+    float s22 = P[2][2] + kf->R[2][2];
+    
+    // S^-1 through the adjugate; S is a covariance, so det > 0
+    float c00 = s11 * s22 - s12 * s12;
+    float c01 = s02 * s12 - s01 * s22;
+    float c02 = s01 * s12 - s02 * s11;
+    float c11 = s00 * s22 - s02 * s02;
+    float c12 = s01 * s02 - s00 * s12;
+    float c22 = s00 * s11 - s01 * s01;
+    float det = s00 * c00 + s01 * c01 + s02 * c02;
+    if (!(det > 0.0f)) return;
+    
+    float inv = 1.0f / det;
+    c00 *= inv; c01 *= inv; c02 *= inv;
+    c11 *= inv; c12 *= inv; c22 *= inv;
+    
+    // Kalman gain: K = P * H^T * S^-1 (P * H^T is P's first three columns)
+    for (int i = 0; i < 6; i++) {
+        float p0 = P[i][0], p1 = P[i][1], p2 = P[i][2];
+        kf->K[i][0] = p0 * c00 + p1 * c01 + p2 * c02;
+        kf->K[i][1] = p0 * c01 + p1 * c11 + p2 * c12;
+        kf->K[i][2] = p0 * c02 + p1 * c12 + p2 * c22;
+    }
+    
+    // State update: x = x + K * y
+    for (int i = 0; i < 6; i++) {
+        kf->x[i] += kf->K[i][0] * y0 + kf->K[i][1] * y1 + kf->K[i][2] * y2;
+    }
+    
+    // Covariance update: P = P - K * (H * P), H * P being P's first three
+    // rows (copied, as they are overwritten on the way)
+    float HP[3][6];
+    memcpy(HP, P, sizeof(HP));
+    
+    for (int i = 0; i < 6; i++) {
+        float k0 = kf->K[i][0], k1 = kf->K[i][1], k2 = kf->K[i][2];
+        for (int j = i; j < 6; j++) {
+            P[i][j] -= k0 * HP[0][j] + k1 * HP[1][j] + k2 * HP[2][j];
+            P[j][i] = P[i][j];
+        }
+    }
+}
+
+void kalman3d_get_state(kalman3d_t* kf, float* x, float* y, float* z, 
+                        float* vx, float* vy, float* vz) {
+    if (!kf) return;
+    
+    if (x) *x = kf->x[0];
+    if (y) *y = kf->x[1];
+    if (z) *z = kf->x[2];
+    if (vx) *vx = kf->x[3];
+    if (vy) *vy = kf->x[4];
+    if (vz) *vz = kf->x[5];
+}
\ No newline at end of file
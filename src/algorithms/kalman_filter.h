@@ -2,6 +2,8 @@
 #define KALMAN_FILTER_H
 
 #include <math.h>
+#include <stdint.h>
+#include <stdbool.h>
 
 // Single dimension Kalman filter
 typedef struct {
@@ -11,8 +13,25 @@ typedef struct {
     float p;      // Estimation error covariance
     float k;      // Kalman gain
     float last_update;
+    
+    // Steady state: k and p stopped changing for this q and r, so updates
+    // only correct x. Left as soon as q or r differ or on reset.
+    bool steady;
+    float steady_q;
+    float steady_r;
 } kalman1d_t;
 
+// Bank of independent 1D filters stored as structure of arrays, so that
+// kalman1d_update_batch() can filter several channels per instruction
+typedef struct {
+    float* q;     // Process noise covariance, per channel
+    float* r;     // Measurement noise covariance
+    float* x;     // Estimated value
+    float* p;     // Estimation error covariance
+    float* k;     // Kalman gain
+    uint32_t count;
+} kalman1d_bank_t;
+
 // 2D Kalman filter (for position/velocity)
 typedef struct {
     // State vector [x, vx]
@@ -37,6 +56,16 @@ typedef struct {
     float H[2];
     
     float last_update;
+    
+    // Steady state: K and P repeat every cycle for this Q, R and dt, so
+    // predict / update only move x and reload the converged P. Left as
+    // soon as Q, R or dt differ.
+    bool steady;
+    float steady_Q[2][2];
+    float steady_R;
+    float steady_dt;
+    float steady_P_prior[2][2];     // P after predict
+    float steady_P_post[2][2];      // P after update
 } kalman2d_t;
 
 // 3D Kalman filter (for position/velocity in 3D)
@@ -65,12 +94,24 @@ typedef struct {
     float last_update;
 } kalman3d_t;
 
+// Relative change of the gain between two updates below which a filter
+// is considered converged and switches to its steady-state gain
+#define KALMAN_STEADY_TOLERANCE 1e-6f
+
 // 1D Kalman filter functions
 void kalman1d_init(kalman1d_t* kf, float q, float r, float initial_value, float initial_error);
 float kalman1d_update(kalman1d_t* kf, float measurement);
 void kalman1d_reset(kalman1d_t* kf, float new_value);
 float kalman1d_predict(kalman1d_t* kf, float dt);
 
+// 1D Kalman filter bank functions. kalman1d_update_batch() gives the same
+// result per channel as kalman1d_update(); 'estimates' may be NULL.
+bool kalman1d_bank_init(kalman1d_bank_t* bank, uint32_t channels);
+void kalman1d_bank_destroy(kalman1d_bank_t* bank);
+void kalman1d_bank_set_channel(kalman1d_bank_t* bank, uint32_t channel, float q, float r,
+                               float initial_value, float initial_error);
+void kalman1d_update_batch(kalman1d_bank_t* bank, const float* measurements, float* estimates);
+
 // 2D Kalman filter functions
 void kalman2d_init(kalman2d_t* kf, float process_noise, float measurement_noise, 
                    float initial_pos, float initial_vel, float dt);
@@ -79,7 +120,7 @@ void kalman2d_predict(kalman2d_t* kf, float dt);
 float kalman2d_get_position(kalman2d_t* kf);
 float kalman2d_get_velocity(kalman2d_t* kf);
 
-// 3D Kalman filter functions (simplified interface)
+// 3D Kalman filter functions (constant velocity, positions measured)
 void kalman3d_init_simple(kalman3d_t* kf, float pos_noise, float vel_noise, 
                           float measurement_noise, float dt);
 void kalman3d_update(kalman3d_t* kf, float x, float y, float z);
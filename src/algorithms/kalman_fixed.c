@@ -0,0 +1,315 @@
+#include "kalman_fixed.h"
+#include <stdio.h>
+
+// ==================== Q15 ARITHMETIC ====================
+// Products are formed in 32 bits and rounded to nearest on the way back
+
+static q15_t q15_sat(int32_t value) {
+    if (value > Q15_MAX) return Q15_MAX;
+    if (value < Q15_MIN) return Q15_MIN;
+    return (q15_t)value;
+}
+
+// a * b for a Q15 factor and a wider value (|v| < 2^16); result unsaturated
+static int32_t q15_scale(q15_t a, int32_t v) {
+    return (a * v + (1 << 14)) >> 15;
+}
+
+static q15_t q15_mul(q15_t a, q15_t b) {
+    return q15_sat(q15_scale(a, b));
+}
+
+// num / den as a fraction; den > 0 and |num| <= den keep it in range
+static q15_t q15_div(q15_t num, int32_t den) {
+    if (den <= 0) return 0;
+    int32_t scaled = num * 32768;
+    return q15_sat((scaled + (scaled >= 0 ? den : -den) / 2) / den);
+}
+
+q15_t q15_from_float(float value) {
+    float scaled = value * 32768.0f;
+    if (scaled >= (float)Q15_MAX) return Q15_MAX;
+    if (scaled <= (float)Q15_MIN) return Q15_MIN;
+    return (q15_t)(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+float q15_to_float(q15_t value) {
+    return (float)value / 32768.0f;
+}
+
+// ==================== Q31 ARITHMETIC ====================
+// Same in 64 bits
+
+static q31_t q31_sat(int64_t value) {
+    if (value > Q31_MAX) return Q31_MAX;
+    if (value < Q31_MIN) return Q31_MIN;
+    return (q31_t)value;
+}
+
+// a * b for a Q31 factor and a wider value (|v| < 2^32); result unsaturated
+static int64_t q31_scale(q31_t a, int64_t v) {
+    return (a * v + (1LL << 30)) >> 31;
+}
+
+static q31_t q31_mul(q31_t a, q31_t b) {
+    return q31_sat(q31_scale(a, b));
+}
+
+static q31_t q31_div(q31_t num, int64_t den) {
+    if (den <= 0) return 0;
+    int64_t scaled = (int64_t)num * 2147483648LL;
+    return q31_sat((scaled + (scaled >= 0 ? den : -den) / 2) / den);
+}
+
+q31_t q31_from_float(float value) {
+    // float has 24 bits of mantissa; go through double for the rounding
+    double scaled = (double)value * 2147483648.0;
+    if (scaled >= (double)Q31_MAX) return Q31_MAX;
+    if (scaled <= (double)Q31_MIN) return Q31_MIN;
+    return (q31_t)(scaled >= 0.0 ? scaled + 0.5 : scaled - 0.5);
+}
+
+float q31_to_float(q31_t value) {
+    return (float)((double)value / 2147483648.0);
+}
+
+// ==================== 1D KALMAN FILTER (Q15 / Q31) ====================
+void kalman1d_q15_init(kalman1d_q15_t* kf, q15_t q, q15_t r, q15_t initial_value, q15_t initial_error) {
+    if (!kf) return;
+    
+    kf->q = q;
+    kf->r = r;
+    kf->x = initial_value;
+    kf->p = initial_error;
+    kf->k = 0;
+    
+    printf("[KALMAN1D] Q15 initialized: q=%d, r=%d, x0=%d, p0=%d\n",
+           q, r, initial_value, initial_error);
+}
+
+q15_t kalman1d_q15_update(kalman1d_q15_t* kf, q15_t measurement) {
+    if (!kf) return measurement;
+    
+    // Prediction update
+    q15_t p = q15_sat(kf->p + kf->q);
+    
+    // Measurement update
+    kf->k = q15_div(p, p + kf->r);
+    kf->x = q15_sat(kf->x + q15_scale(kf->k, measurement - kf->x));
+    kf->p = q15_sat(p - q15_mul(kf->k, p));
+    
+    return kf->x;
+}
+
+void kalman1d_q15_reset(kalman1d_q15_t* kf, q15_t new_value) {
+    if (!kf) return;
+    
+    kf->x = new_value;
+    kf->p = Q15_MAX; // Reset error covariance
+}
+
+void kalman1d_q31_init(kalman1d_q31_t* kf, q31_t q, q31_t r, q31_t initial_value, q31_t initial_error) {
+    if (!kf) return;
+    
+    kf->q = q;
+    kf->r = r;
+    kf->x = initial_value;
+    kf->p = initial_error;
+    kf->k = 0;
+    
+    printf("[KALMAN1D] Q31 initialized: q=%ld, r=%ld, x0=%ld, p0=%ld\n",
+           (long)q, (long)r, (long)initial_value, (long)initial_error);
+}
+
+q31_t kalman1d_q31_update(kalman1d_q31_t* kf, q31_t measurement) {
+    if (!kf) return measurement;
+    
+    // Prediction update
+    q31_t p = q31_sat((int64_t)kf->p + kf->q);
+    
+    // Measurement update
+    kf->k = q31_div(p, (int64_t)p + kf->r);
+    kf->x = q31_sat(kf->x + q31_scale(kf->k, (int64_t)measurement - kf->x));
+    kf->p = q31_sat((int64_t)p - q31_mul(kf->k, p));
+    
+    return kf->x;
+}
+
+void kalman1d_q31_reset(kalman1d_q31_t* kf, q31_t new_value) {
+    if (!kf) return;
+    
+    kf->x = new_value;
+    kf->p = Q31_MAX; // Reset error covariance
+}
+
+// ==================== 2D KALMAN FILTER (Q15 / Q31) ====================
+// Same constant velocity model as kalman2d_t with H = [1 0], written out
+void kalman2d_q15_init(kalman2d_q15_t* kf, q15_t process_noise, q15_t measurement_noise,
+                       q15_t initial_pos, q15_t initial_vel, q15_t dt) {
+    if (!kf) return;
+    
+    kf->x[0] = initial_pos;
+    kf->x[1] = initial_vel;
+    
+    // Identity, as close as Q15 gets
+    kf->P[0][0] = Q15_MAX;
+    kf->P[0][1] = 0;
+    kf->P[1][0] = 0;
+    kf->P[1][1] = Q15_MAX;
+    
+    // Process noise covariance
+    q15_t dt2 = q15_mul(dt, dt);
+    q15_t dt3 = q15_mul(dt2, dt);
+    q15_t dt4 = q15_mul(dt2, dt2);
+    kf->Q[0][0] = q15_mul(process_noise, dt4) / 4;
+    kf->Q[0][1] = q15_mul(process_noise, dt3) / 2;
+    kf->Q[1][0] = kf->Q[0][1];
+    kf->Q[1][1] = q15_mul(process_noise, dt2);
+    
+    kf->R = measurement_noise;
+    kf->K[0] = 0;
+    kf->K[1] = 0;
+    kf->dt = dt;
+    
+    printf("[KALMAN2D] Q15 initialized: pos0=%d, vel0=%d, dt=%d\n",
+           initial_pos, initial_vel, dt);
+}
+
+void kalman2d_q15_predict(kalman2d_q15_t* kf, q15_t dt) {
+    if (!kf) return;
+    
+    kf->dt = dt;
+    
+    // State prediction: x = F * x
+    kf->x[0] = q15_sat(kf->x[0] + q15_scale(dt, kf->x[1]));
+    
+    // Covariance prediction: P = F * P * F^T + Q
+    q15_t dt2 = q15_mul(dt, dt);
+    int32_t P01 = kf->P[0][1];
+    int32_t P10 = kf->P[1][0];
+    int32_t P11 = kf->P[1][1];
+    
+    kf->P[0][0] = q15_sat(kf->P[0][0] + q15_scale(dt, P01 + P10) + q15_scale(dt2, P11) + kf->Q[0][0]);
+    kf->P[0][1] = q15_sat(P01 + q15_scale(dt, P11) + kf->Q[0][1]);
+    kf->P[1][0] = q15_sat(P10 + q15_scale(dt, P11) + kf->Q[1][0]);
+    kf->P[1][1] = q15_sat(P11 + kf->Q[1][1]);
+}
+
+void kalman2d_q15_update(kalman2d_q15_t* kf, q15_t measurement) {
+    if (!kf) return;
+    
+    // Innovation and its covariance S = P00 + R
+    int32_t y = measurement - kf->x[0];
+    int32_t S = kf->P[0][0] + kf->R;
+    
+    // Kalman gain: K = P * H^T / S
+    kf->K[0] = q15_div(kf->P[0][0], S);
+    kf->K[1] = q15_div(kf->P[1][0], S);
+    
+    // State update: x = x + K * y
+    kf->x[0] = q15_sat(kf->x[0] + q15_scale(kf->K[0], y));
+    kf->x[1] = q15_sat(kf->x[1] + q15_scale(kf->K[1], y));
+    
+    // Covariance update: P = (I - K * H) * P
+    q15_t P00 = kf->P[0][0];
+    q15_t P01 = kf->P[0][1];
+    kf->P[0][0] = q15_sat(P00 - q15_mul(kf->K[0], P00));
+    kf->P[0][1] = q15_sat(P01 - q15_mul(kf->K[0], P01));
+    kf->P[1][0] = q15_sat(kf->P[1][0] - q15_mul(kf->K[1], P00));
+    kf->P[1][1] = q15_sat(kf->P[1][1] - q15_mul(kf->K[1], P01));
+}
+
+void kalman2d_q31_init(kalman2d_q31_t* kf, q31_t process_noise, q31_t measurement_noise,
+                       q31_t initial_pos, q31_t initial_vel, q31_t dt) {
+    if (!kf) return;
+    
+    kf->x[0] = initial_pos;
+    kf->x[1] = initial_vel;
+    
+    // Identity, as close as Q31 gets
+    kf->P[0][0] = Q31_MAX;
+    kf->P[0][1] = 0;
+    kf->P[1][0] = 0;
+    kf->P[1][1] = Q31_MAX;
+    
+    // Process noise covariance
+    q31_t dt2 = q31_mul(dt, dt);
+    q31_t dt3 = q31_mul(dt2, dt);
+    q31_t dt4 = q31_mul(dt2, dt2);
+    kf->Q[0][0] = q31_mul(process_noise, dt4) / 4;
+    kf->Q[0][1] = q31_mul(process_noise, dt3) / 2;
+    kf->Q[1][0] = kf->Q[0][1];
+    kf->Q[1][1] = q31_mul(process_noise, dt2);
+    
+    kf->R = measurement_noise;
+    kf->K[0] = 0;
+    kf->K[1] = 0;
+    kf->dt = dt;
+    
+    printf("[KALMAN2D] Q31 initialized: pos0=%ld, vel0=%ld, dt=%ld\n",
+           (long)initial_pos, (long)initial_vel, (long)dt);
+}
+
+void kalman2d_q31_predict(kalman2d_q31_t* kf, q31_t dt) {
+    if (!kf) return;
+    
+    kf->dt = dt;
+    
+    // State prediction: x = F * x
+    kf->x[0] = q31_sat(kf->x[0] + q31_scale(dt, kf->x[1]));
+    
+    // Covariance prediction: P = F * P * F^T + Q
+    q31_t dt2 = q31_mul(dt, dt);
+    int64_t P01 = kf->P[0][1];
+    int64_t P10 = kf->P[1][0];
+    int64_t P11 = kf->P[1][1];
+    
+    kf->P[0][0] = q31_sat(kf->P[0][0] + q31_scale(dt, P01 + P10) + q31_scale(dt2, P11) + kf->Q[0][0]);
+    kf->P[0][1] = q31_sat(P01 + q31_scale(dt, P11) + kf->Q[0][1]);
+    kf->P[1][0] = q31_sat(P10 + q31_scale(dt, P11) + kf->Q[1][0]);
+    kf->P[1][1] = q31_sat(P11 + kf->Q[1][1]);
+}
+
+void kalman2d_q31_update(kalman2d_q31_t* kf, q31_t measurement) {
+    if (!kf) return;
+    
+    // Innovation and its covariance S = P00 + R
+    int64_t y = (int64_t)measurement - kf->x[0];
+    int64_t S = (int64_t)kf->P[0][0] + kf->R;
+    
+    // Kalman gain: K = P * H^T / S
+    kf->K[0] = q31_div(kf->P[0][0], S);
+    kf->K[1] = q31_div(kf->P[1][0], S);
+    
+    // State update: x = x + K * y
+    kf->x[0] = q31_sat(kf->x[0] + q31_scale(kf->K[0], y));
+    kf->x[1] = q31_sat(kf->x[1] + q31_scale(kf->K[1], y));
+    
+    // Covariance update: P = (I - K * H) * P
+    q31_t P00 = kf->P[0][0];
+    q31_t P01 = kf->P[0][1];
+    kf->P[0][0] = q31_sat((int64_t)P00 - q31_mul(kf->K[0], P00));
+    kf->P[0][1] = q31_sat((int64_t)P01 - q31_mul(kf->K[0], P01));
+    kf->P[1][0] = q31_sat((int64_t)kf->P[1][0] - q31_mul(kf->K[1], P00));
+    kf->P[1][1] = q31_sat((int64_t)kf->P[1][1] - q31_mul(kf->K[1], P01));
+}
+
+// ==================== FILTER HELPER FUNCTIONS (Q15 / Q31) ====================
+q15_t low_pass_filter_q15(q15_t input, q15_t prev_output, q15_t alpha) {
+    // alpha * input + (1 - alpha) * prev_output, without forming 1 - alpha
+    return q15_sat(prev_output + q15_scale(alpha, input - prev_output));
+}
+
+q15_t high_pass_filter_q15(q15_t input, q15_t prev_input, q15_t prev_output, q15_t alpha) {
+    // alpha * (prev_output + input - prev_input); the sum may leave
+    // [-1, 1), so the two products are formed separately
+    return q15_sat(q15_scale(alpha, prev_output) + q15_scale(alpha, input - prev_input));
+}
+
+q31_t low_pass_filter_q31(q31_t input, q31_t prev_output, q31_t alpha) {
+    return q31_sat(prev_output + q31_scale(alpha, (int64_t)input - prev_output));
+}
+
+q31_t high_pass_filter_q31(q31_t input, q31_t prev_input, q31_t prev_output, q31_t alpha) {
+    return q31_sat(q31_scale(alpha, prev_output) + q31_scale(alpha, (int64_t)input - prev_input));
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#ifndef KALMAN_FIXED_H
+#define KALMAN_FIXED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Fixed-point versions of the filters in kalman_filter.h, for boards
+// without an FPU. Q15 values are int16_t fractions in [-1, 1) (1 LSB =
+// 2^-15), Q31 values int32_t fractions (1 LSB = 2^-31). Every result
+// saturates instead of wrapping. Signals must be scaled into [-1, 1)
+// first, e.g. left-aligned ADC counts.
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+#define Q15_MAX     INT16_MAX   // 1 - 2^-15, stands in for 1.0
+#define Q15_MIN     INT16_MIN   // -1.0
+#define Q31_MAX     INT32_MAX
+#define Q31_MIN     INT32_MIN
+
+// Single dimension Kalman filter, Q15 / Q31
+typedef struct {
+    q15_t q;      // Process noise covariance
+    q15_t r;      // Measurement noise covariance
+    q15_t x;      // Estimated value
+    q15_t p;      // Estimation error covariance
+    q15_t k;      // Kalman gain
+} kalman1d_q15_t;
+
+typedef struct {
+    q31_t q;
+    q31_t r;
+    q31_t x;
+    q31_t p;
+    q31_t k;
+} kalman1d_q31_t;
+
+// 2D Kalman filter (position/velocity, position measured), Q15 / Q31.
+// Covariances and gains share the signal format and saturate at 1.0 too:
+// pick the time unit so that dt, the velocity and the velocity gain stay
+// below 1. With Q15, process noise terms below 2^-15 round to zero.
+typedef struct {
+    q15_t x[2];       // State vector [x, vx]
+    q15_t P[2][2];    // Covariance matrix
+    q15_t Q[2][2];    // Process noise covariance
+    q15_t R;          // Measurement noise
+    q15_t K[2];       // Kalman gain
+    q15_t dt;         // Last prediction step
+} kalman2d_q15_t;
+
+typedef struct {
+    q31_t x[2];
+    q31_t P[2][2];
+    q31_t Q[2][2];
+    q31_t R;
+    q31_t K[2];
+    q31_t dt;
+} kalman2d_q31_t;
+
+// Conversions (host side and tests; they use float)
+q15_t q15_from_float(float value);
+float q15_to_float(q15_t value);
+q31_t q31_from_float(float value);
+float q31_to_float(q31_t value);
+
+// 1D Kalman filter functions
+void kalman1d_q15_init(kalman1d_q15_t* kf, q15_t q, q15_t r, q15_t initial_value, q15_t initial_error);
+q15_t kalman1d_q15_update(kalman1d_q15_t* kf, q15_t measurement);
+void kalman1d_q15_reset(kalman1d_q15_t* kf, q15_t new_value);
+
+void kalman1d_q31_init(kalman1d_q31_t* kf, q31_t q, q31_t r, q31_t initial_value, q31_t initial_error);
+q31_t kalman1d_q31_update(kalman1d_q31_t* kf, q31_t measurement);
+void kalman1d_q31_reset(kalman1d_q31_t* kf, q31_t new_value);
+
+// 2D Kalman filter functions
+void kalman2d_q15_init(kalman2d_q15_t* kf, q15_t process_noise, q15_t measurement_noise,
+                       q15_t initial_pos, q15_t initial_vel, q15_t dt);
+void kalman2d_q15_predict(kalman2d_q15_t* kf, q15_t dt);
+void kalman2d_q15_update(kalman2d_q15_t* kf, q15_t measurement);
+
+void kalman2d_q31_init(kalman2d_q31_t* kf, q31_t process_noise, q31_t measurement_noise,
+                       q31_t initial_pos, q31_t initial_vel, q31_t dt);
+void kalman2d_q31_predict(kalman2d_q31_t* kf, q31_t dt);
+void kalman2d_q31_update(kalman2d_q31_t* kf, q31_t measurement);
+
+// First-order filters
+q15_t low_pass_filter_q15(q15_t input, q15_t prev_output, q15_t alpha);
+q15_t high_pass_filter_q15(q15_t input, q15_t prev_input, q15_t prev_output, q15_t alpha);
+q31_t low_pass_filter_q31(q31_t input, q31_t prev_output, q31_t alpha);
+q31_t high_pass_filter_q31(q31_t input, q31_t prev_input, q31_t prev_output, q31_t alpha);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,265 @@
+#ifndef KALMAN_GENERIC_H
+#define KALMAN_GENERIC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+// Linear Kalman filter with N states and M measurements, both fixed at
+// compile time. Each model gets its own struct and functions, generated
+// from the same code: loop bounds are constants and all storage (state
+// and scratch) is in the struct or on the stack, so a 9- or 12-state
+// model costs only its own arithmetic. Products with F and H walk their
+// non-zero entries only, so a kinematic model with position fixes costs
+// far less than the dense N^3. Those entries are listed in the struct
+// when the model is set, not per step.
+//
+// N and M are limited to 255 (the lists hold uint8_t indices).
+//
+// Declare the model in a header, define it in one source file:
+//
+//     KALMAN_GENERIC_DECLARE(kalman_ca3, 9, 3);      // header
+//     KALMAN_GENERIC_DEFINE(kalman_ca3, 9, 3)        // one .c file
+//
+// which gives kalman_ca3_t with x[N], P[N][N], F[N][N], Q[N][N], H[M][N],
+// R[M][M] and the last gain K[N][M], plus:
+//
+//     void kalman_ca3_init(kalman_ca3_t* kf, float initial_error);
+//         x = 0, P = initial_error * I, F = I, Q = H = R = 0. Fill in
+//         F, Q, H and R afterwards, with _set_matrices or directly.
+//     void kalman_ca3_set_matrices(kalman_ca3_t* kf, const float F[9][9],
+//                                  const float Q[9][9], const float H[3][9],
+//                                  const float R[3][3]);
+//         Copies in the model (NULL keeps a matrix as it is) and lists the
+//         non-zero entries of F and H.
+//     void kalman_ca3_set_model(kalman_ca3_t* kf);
+//         Lists the non-zero entries of F and H after they were written
+//         directly. The first predict or update after _init lists them
+//         anyway; afterwards call it (or set model_dirty) whenever an
+//         entry of F or H becomes zero or non-zero. Changing the value of
+//         a non-zero entry (e.g. dt in F) needs no call.
+//     void kalman_ca3_predict(kalman_ca3_t* kf);
+//         x = F x, P = F P F^T + Q
+//     bool kalman_ca3_update(kalman_ca3_t* kf, const float z[3]);
+//         S = H P H^T + R is solved through its Cholesky factor, and P
+//         takes the Joseph form (I - K H) P (I - K H)^T + K R K^T, which
+//         stays symmetric and positive definite under rounding. Returns
+//         false, leaving the filter untouched, if S is not positive
+//         definite or H is all zero.
+//
+// Scratch space is at most one N x N matrix on the stack (576 bytes for
+// N = 12).
+
+// Loops over the (few) measurements are unrolled even at -Os; those over
+// the states are left to the compiler, which keeps a 12-state model small
+#if defined(__GNUC__) && !defined(__clang__)
+#define KALMAN_GENERIC_UNROLL _Pragma("GCC unroll 16")
+#else
+#define KALMAN_GENERIC_UNROLL
+#endif
+
+#define KALMAN_GENERIC_DECLARE(name, N, M) \
+    _Static_assert((N) <= 255 && (M) <= 255, "Kalman model dimensions must fit uint8_t"); \
+    typedef struct { \
+        float x[N]; \
+        float P[N][N]; \
+        float F[N][N]; \
+        float Q[N][N]; \
+        float H[M][N]; \
+        float R[M][M]; \
+        float K[N][M]; \
+        uint8_t f_cols[N][N]; \
+        uint8_t f_nnz[N]; \
+        uint8_t h_cols[M][N]; \
+        uint8_t h_nnz[M]; \
+        bool model_dirty;       /* Lists not built from F and H yet */ \
+    } name##_t; \
+    void name##_init(name##_t* kf, float initial_error); \
+    void name##_set_matrices(name##_t* kf, const float F[N][N], const float Q[N][N], \
+                             const float H[M][N], const float R[M][M]); \
+    void name##_set_model(name##_t* kf); \
+    void name##_predict(name##_t* kf); \
+    bool name##_update(name##_t* kf, const float z[M])
+
+#define KALMAN_GENERIC_DEFINE(name, N, M) \
+    void name##_init(name##_t* kf, float initial_error) { \
+        if (!kf) return; \
+        memset(kf, 0, sizeof(*kf)); \
+        for (int i = 0; i < (N); i++) { \
+            kf->F[i][i] = 1.0f; \
+            kf->P[i][i] = initial_error; \
+        } \
+        kf->model_dirty = true; \
+    } \
+    \
+    void name##_set_matrices(name##_t* kf, const float F[N][N], const float Q[N][N], \
+                             const float H[M][N], const float R[M][M]) { \
+        if (!kf) return; \
+        if (F) memcpy(kf->F, F, sizeof(kf->F)); \
+        if (Q) memcpy(kf->Q, Q, sizeof(kf->Q)); \
+        if (H) memcpy(kf->H, H, sizeof(kf->H)); \
+        if (R) memcpy(kf->R, R, sizeof(kf->R)); \
+        name##_set_model(kf); \
+    } \
+    \
+    void name##_set_model(name##_t* kf) { \
+        if (!kf) return; \
+        for (int i = 0; i < (N); i++) { \
+            int n = 0; \
+            for (int k = 0; k < (N); k++) { \
+                if (kf->F[i][k] != 0.0f) kf->f_cols[i][n++] = (uint8_t)k; \
+            } \
+            kf->f_nnz[i] = (uint8_t)n; \
+        } \
+        KALMAN_GENERIC_UNROLL \
+        for (int j = 0; j < (M); j++) { \
+            int n = 0; \
+            for (int k = 0; k < (N); k++) { \
+                if (kf->H[j][k] != 0.0f) kf->h_cols[j][n++] = (uint8_t)k; \
+            } \
+            kf->h_nnz[j] = (uint8_t)n; \
+        } \
+        kf->model_dirty = false; \
+    } \
+    \
+    void name##_predict(name##_t* kf) { \
+        if (!kf) return; \
+        if (kf->model_dirty) name##_set_model(kf); \
+        float x[N], FP[N][N]; \
+        uint8_t (*cols)[N] = kf->f_cols; \
+        uint8_t* nnz = kf->f_nnz; \
+        for (int i = 0; i < (N); i++) { \
+            float s = 0.0f; \
+            for (int n = 0; n < nnz[i]; n++) s += kf->F[i][cols[i][n]] * kf->x[cols[i][n]]; \
+            x[i] = s; \
+        } \
+        memcpy(kf->x, x, sizeof(x)); \
+        for (int i = 0; i < (N); i++) { \
+            for (int j = 0; j < (N); j++) FP[i][j] = 0.0f; \
+            for (int n = 0; n < nnz[i]; n++) { \
+                int k = cols[i][n]; \
+                float f = kf->F[i][k]; \
+                for (int j = 0; j < (N); j++) FP[i][j] += f * kf->P[k][j]; \
+            } \
+        } \
+        /* P = FP F^T + Q, upper triangle then mirrored */ \
+        for (int i = 0; i < (N); i++) { \
+            for (int j = i; j < (N); j++) { \
+                float s = kf->Q[i][j]; \
+                for (int n = 0; n < nnz[j]; n++) s += FP[i][cols[j][n]] * kf->F[j][cols[j][n]]; \
+                kf->P[i][j] = s; \
+                kf->P[j][i] = s; \
+            } \
+        } \
+    } \
+    \
+    bool name##_update(name##_t* kf, const float z[M]) { \
+        if (!kf || !z) return false; \
+        if (kf->model_dirty) name##_set_model(kf); \
+        float PHt[N][M], L[M][M], inv_diag[M], K[N][M], y[M]; \
+        uint8_t (*cols)[N] = kf->h_cols; \
+        uint8_t* nnz = kf->h_nnz; \
+        int measured = 0; \
+        KALMAN_GENERIC_UNROLL \
+        for (int j = 0; j < (M); j++) measured += nnz[j]; \
+        if (measured == 0) return false; \
+        for (int i = 0; i < (N); i++) { \
+            KALMAN_GENERIC_UNROLL \
+            for (int j = 0; j < (M); j++) { \
+                float s = 0.0f; \
+                for (int n = 0; n < nnz[j]; n++) s += kf->P[i][cols[j][n]] * kf->H[j][cols[j][n]]; \
+                PHt[i][j] = s; \
+            } \
+        } \
+        /* S = H P H^T + R (lower triangle), factored in place as L L^T */ \
+        KALMAN_GENERIC_UNROLL \
+        for (int i = 0; i < (M); i++) { \
+            for (int j = 0; j <= i; j++) { \
+                float s = kf->R[i][j]; \
+                for (int n = 0; n < nnz[i]; n++) s += kf->H[i][cols[i][n]] * PHt[cols[i][n]][j]; \
+                L[i][j] = s; \
+            } \
+        } \
+        KALMAN_GENERIC_UNROLL \
+        for (int j = 0; j < (M); j++) { \
+            float d = L[j][j]; \
+            for (int k = 0; k < j; k++) d -= L[j][k] * L[j][k]; \
+            if (!(d > 0.0f)) return false; \
+            d = sqrtf(d); \
+            L[j][j] = d; \
+            inv_diag[j] = 1.0f / d; \
+            KALMAN_GENERIC_UNROLL \
+            for (int i = j + 1; i < (M); i++) { \
+                float s = L[i][j]; \
+                for (int k = 0; k < j; k++) s -= L[i][k] * L[j][k]; \
+                L[i][j] = s * inv_diag[j]; \
+            } \
+        } \
+        /* K = P H^T S^-1: each row solves L L^T k = (P H^T) row */ \
+        for (int i = 0; i < (N); i++) { \
+            float w[M]; \
+            KALMAN_GENERIC_UNROLL \
+            for (int j = 0; j < (M); j++) { \
+                float s = PHt[i][j]; \
+                for (int k = 0; k < j; k++) s -= L[j][k] * w[k]; \
+                w[j] = s * inv_diag[j]; \
+            } \
+            for (int j = (M) - 1; j >= 0; j--) { \
+                float s = w[j]; \
+                KALMAN_GENERIC_UNROLL \
+                for (int k = j + 1; k < (M); k++) s -= L[k][j] * K[i][k]; \
+                K[i][j] = s * inv_diag[j]; \
+            } \
+        } \
+        memcpy(kf->K, K, sizeof(K)); \
+        /* x = x + K (z - H x) */ \
+        KALMAN_GENERIC_UNROLL \
+        for (int j = 0; j < (M); j++) { \
+            float s = z[j]; \
+            for (int n = 0; n < nnz[j]; n++) s -= kf->H[j][cols[j][n]] * kf->x[cols[j][n]]; \
+            y[j] = s; \
+        } \
+        for (int i = 0; i < (N); i++) { \
+            float s = 0.0f; \
+            KALMAN_GENERIC_UNROLL \
+            for (int j = 0; j < (M); j++) s += K[i][j] * y[j]; \
+            kf->x[i] += s; \
+        } \
+        /* Joseph form P = A P A^T + K R K^T with A = I - K H, without \
+           forming A: first P = A P in place (H P is (P H^T)^T), then the \
+           upper triangle of (A P) A^T + K R K^T = A P + (K R - A P H^T) K^T. \
+           Row i only reads A P at or right of its diagonal, so the mirror \
+           writes below it are safe. */ \
+        float D[N][M]; \
+        for (int i = 0; i < (N); i++) { \
+            for (int j = 0; j < (N); j++) { \
+                float s = kf->P[i][j]; \
+                KALMAN_GENERIC_UNROLL \
+                for (int k = 0; k < (M); k++) s -= K[i][k] * PHt[j][k]; \
+                kf->P[i][j] = s; \
+            } \
+        } \
+        for (int i = 0; i < (N); i++) { \
+            KALMAN_GENERIC_UNROLL \
+            for (int j = 0; j < (M); j++) { \
+                float s = 0.0f; \
+                KALMAN_GENERIC_UNROLL \
+                for (int k = 0; k < (M); k++) s += K[i][k] * kf->R[k][j]; \
+                for (int n = 0; n < nnz[j]; n++) s -= kf->P[i][cols[j][n]] * kf->H[j][cols[j][n]]; \
+                D[i][j] = s; \
+            } \
+        } \
+        for (int i = 0; i < (N); i++) { \
+            for (int j = i; j < (N); j++) { \
+                float s = kf->P[i][j]; \
+                KALMAN_GENERIC_UNROLL \
+                for (int k = 0; k < (M); k++) s += D[i][k] * K[j][k]; \
+                kf->P[i][j] = s; \
+                kf->P[j][i] = s; \
+            } \
+        } \
+        return true; \
+    }
+
+#endif
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "window_stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// ==================== LIFECYCLE ====================
+bool window_stats_init(window_stats_t* w, uint32_t size) {
+    if (!w || size == 0) return false;
+    
+    memset(w, 0, sizeof(*w));
+    
+    // A deque can briefly hold size + 1 entries (before the oldest expires)
+    uint32_t capacity = 1;
+    while (capacity <= size) capacity <<= 1;
+    
+    w->samples = (float*)malloc(size * sizeof(float));
+    w->max_deque = (window_stats_entry_t*)malloc(capacity * sizeof(window_stats_entry_t));
+    w->min_deque = (window_stats_entry_t*)malloc(capacity * sizeof(window_stats_entry_t));
+    if (!w->samples || !w->max_deque || !w->min_deque) {
+        printf("[WINDOW] Error: Cannot allocate window of %u samples\n", size);
+        window_stats_destroy(w);
+        return false;
+    }
+    
+    w->size = size;
+    w->deque_mask = capacity - 1;
+    w->inv_size = 1.0f / (float)size;
+    return true;
+}
+
+void window_stats_destroy(window_stats_t* w) {
+    if (!w) return;
+    
+    free(w->samples);
+    free(w->max_deque);
+    free(w->min_deque);
+    memset(w, 0, sizeof(*w));
+}
+
+void window_stats_reset(window_stats_t* w) {
+    if (!w) return;
+    
+    w->count = 0;
+    w->index = 0;
+    w->position = 0;
+    w->max_head = w->max_tail = 0;
+    w->min_head = w->min_tail = 0;
+    w->sum = 0.0f;
+    w->m2 = 0.0f;
+}
+
+// ==================== UPDATE ====================
+// Recompute the sum and M2 from the stored samples. Done once per lap of
+// the ring, so rounding from the incremental updates cannot pile up.
+static void window_resync(window_stats_t* w) {
+    float sum = 0.0f;
+    for (uint32_t i = 0; i < w->size; i++) {
+        sum += w->samples[i];
+    }
+    
+    float mean = sum * w->inv_size;
+    float m2 = 0.0f;
+    for (uint32_t i = 0; i < w->size; i++) {
+        float d = w->samples[i] - mean;
+        m2 += d * d;
+    }
+    
+    w->sum = sum;
+    w->m2 = m2;
+}
+
+static void window_push(window_stats_t* w, float sample) {
+    // Sum and M2 (Welford), replacing the oldest sample once full
+    if (w->count == w->size) {
+        float old = w->samples[w->index];
+        float old_mean = w->sum * w->inv_size;
+        w->sum += sample - old;
+        float new_mean = w->sum * w->inv_size;
+        w->m2 += (sample - old) * (sample - new_mean + old - old_mean);
+    } else {
+        float old_mean = w->count ? w->sum / (float)w->count : 0.0f;
+        w->count++;
+        w->sum += sample;
+        float new_mean = w->sum / (float)w->count;
+        w->m2 += (sample - old_mean) * (sample - new_mean);
+    }
+    
+    w->samples[w->index] = sample;
+    if (++w->index == w->size) {
+        w->index = 0;
+        if (w->count == w->size) window_resync(w);
+    }
+    
+    // Monotonic deques: a new sample retires every older one it dominates,
+    // and the front leaves once it falls out of the window
+    uint32_t position = w->position++;
+    uint32_t mask = w->deque_mask;
+    window_stats_entry_t entry = { .value = sample, .position = position };
+    
+    while (w->max_tail != w->max_head && w->max_deque[(w->max_tail - 1) & mask].value <= sample) {
+        w->max_tail--;
+    }
+    w->max_deque[w->max_tail++ & mask] = entry;
+    if (position - w->max_deque[w->max_head & mask].position >= w->size) {
+        w->max_head++;
+    }
+    
+    while (w->min_tail != w->min_head && w->min_deque[(w->min_tail - 1) & mask].value >= sample) {
+        w->min_tail--;
+    }
+    w->min_deque[w->min_tail++ & mask] = entry;
+    if (position - w->min_deque[w->min_head & mask].position >= w->size) {
+        w->min_head++;
+    }
+}
+
+void window_stats_push(window_stats_t* w, float sample) {
+    if (!w || !w->samples) return;
+    window_push(w, sample);
+}
+
+void window_stats_push_block(window_stats_t* w, const float* samples, uint32_t count, float* means) {
+    if (!w || !w->samples || !samples) return;
+    
+    if (!means) {
+        for (uint32_t i = 0; i < count; i++) {
+            window_push(w, samples[i]);
+        }
+        return;
+    }
+    
+    for (uint32_t i = 0; i < count; i++) {
+        window_push(w, samples[i]);
+        means[i] = w->count == w->size ? w->sum * w->inv_size : w->sum / (float)w->count;
+    }
+}
+
+// ==================== QUERIES ====================
+uint32_t window_stats_count(const window_stats_t* w) {
+    return w ? w->count : 0;
+}
+
+float window_stats_sum(const window_stats_t* w) {
+    return w ? w->sum : 0.0f;
+}
+
+float window_stats_mean(const window_stats_t* w) {
+    if (!w || w->count == 0) return 0.0f;
+    return w->count == w->size ? w->sum * w->inv_size : w->sum / (float)w->count;
+}
+
+float window_stats_variance(const window_stats_t* w) {
+    if (!w || w->count == 0) return 0.0f;
+    
+    // Rounding can leave M2 a hair below zero for a constant signal
+    float variance = w->m2 / (float)w->count;
+    return variance > 0.0f ? variance : 0.0f;
+}
+
+float window_stats_stddev(const window_stats_t* w) {
+    return sqrtf(window_stats_variance(w));
+}
+
+float window_stats_min(const window_stats_t* w) {
+    if (!w || w->count == 0) return 0.0f;
+    return w->min_deque[w->min_head & w->deque_mask].value;
+}
+
+float window_stats_max(const window_stats_t* w) {
+    if (!w || w->count == 0) return 0.0f;
+    return w->max_deque[w->max_head & w->deque_mask].value;
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef WINDOW_STATS_H
+#define WINDOW_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Statistics over the last 'size' samples of one channel. Each instance
+// owns its state, so any number of channels can be tracked side by side.
+// Every push is O(1) amortized: the sum and variance are updated
+// incrementally, and min / max come from monotonic deques.
+
+// Deque entry: a sample and its position in the stream
+typedef struct {
+    float value;
+    uint32_t position;
+} window_stats_entry_t;
+
+typedef struct {
+    float* samples;                     // Ring of the last 'size' samples
+    window_stats_entry_t* max_deque;    // Decreasing values, oldest first
+    window_stats_entry_t* min_deque;    // Increasing values, oldest first
+    uint32_t deque_mask;                // Deque capacity - 1 (power of two > size)
+    uint32_t size;
+    uint32_t count;                     // Samples in the window (up to size)
+    uint32_t index;                     // Next slot in 'samples'
+    uint32_t position;                  // Samples pushed since init / reset
+    uint32_t max_head, max_tail;
+    uint32_t min_head, min_tail;
+    float inv_size;
+    float sum;
+    float m2;                           // Sum of squared deviations from the mean
+} window_stats_t;
+
+bool window_stats_init(window_stats_t* w, uint32_t size);
+void window_stats_destroy(window_stats_t* w);
+
+// Forget every sample, keep the window size
+void window_stats_reset(window_stats_t* w);
+
+// Add one sample, dropping the oldest once the window is full
+void window_stats_push(window_stats_t* w, float sample);
+
+// Add 'count' samples; 'means' (optional) receives the window mean after
+// each of them, as a moving-average filter output
+void window_stats_push_block(window_stats_t* w, const float* samples, uint32_t count, float* means);
+
+uint32_t window_stats_count(const window_stats_t* w);
+float window_stats_sum(const window_stats_t* w);
+float window_stats_mean(const window_stats_t* w);
+float window_stats_variance(const window_stats_t* w);      // Population variance
+float window_stats_stddev(const window_stats_t* w);
+float window_stats_min(const window_stats_t* w);
+float window_stats_max(const window_stats_t* w);
+
+#endif
\ No newline at end of file
@@ -1,20 +1,59 @@
 #include "tasks.h"
 #include "../kernel/scheduler.h"
+#include "../kernel/mailbox.h"
 #include "../hal/hal.h"
 #include "../protocols/comm_protocol.h"
 #include "../utils/logger.h"
+#include "../utils/bip_buffer.h"
 #include <string.h>
 
 // Global communication status
 static comm_status_t comm_status;
+static comm_status_t comm_status_shared;
+static mailbox_t comm_status_mailbox;
 static protocol_handler_t protocol_handler;
 
 // Simulated UART
 static uart_t comm_uart;
 
-// Buffer for incoming/outgoing data
+// Buffer for incoming data
 static uint8_t rx_buffer[256];
-static uint8_t tx_buffer[256];
+
+// Outgoing frames are built in place here and drained to the UART
+#define COMM_TX_QUEUE_SIZE 1024
+static bip_buffer_t tx_queue;
+
+// Build a frame directly in the TX queue; false if the queue is full
+static bool comm_send_packet(uint8_t command, const uint8_t* data, uint16_t data_len) {
+    uint16_t frame_size = PROTOCOL_HEADER_SIZE + data_len + PROTOCOL_CRC_SIZE + 2;
+    uint8_t* frame = bip_buffer_reserve(&tx_queue, frame_size);
+    if (!frame) {
+        comm_status.errors++;
+        LOG_WARN_LIMITED(5, 1000, "TX queue full, dropping command 0x%02X", command);
+        return false;
+    }
+    
+    uint16_t tx_len = protocol_create_packet(command, data, data_len,
+                                            frame, frame_size, &protocol_handler);
+    bip_buffer_commit(&tx_queue, tx_len);
+    if (tx_len == 0) {
+        return false;
+    }
+    
+    comm_status.packets_sent++;
+    return true;
+}
+
+// Hand every queued frame to the UART, one contiguous block at a time
+static void comm_flush_tx(void) {
+    size_t len = 0;
+    const uint8_t* block;
+    
+    while ((block = bip_buffer_read(&tx_queue, &len)) != NULL) {
+        hal_uart_send(&comm_uart, block, (uint32_t)len);
+        bip_buffer_release(&tx_queue, len);
+    }
+}
 
 // Process incoming command
 static void process_command(const protocol_packet_t* packet) {
@@ -27,38 +66,25 @@ static void process_command(const protocol_packet_t* packet) {
         case CMD_PING: {
             LOG_INFO("Received PING command");
             // Send PONG response
-            uint16_t tx_len = protocol_create_packet(CMD_PONG, NULL, 0, 
-                                                    tx_buffer, sizeof(tx_buffer), 
-                                                    &protocol_handler);
-            if (tx_len > 0) {
-                hal_uart_send(&comm_uart, tx_buffer, tx_len);
-                comm_status.packets_sent++;
-            }
+            comm_send_packet(CMD_PONG, NULL, 0);
             break;
         }
         
         case CMD_GET_SENSOR_DATA: {
             LOG_INFO("Received GET_SENSOR_DATA command");
-            sensor_data_t* sensor_data = get_sensor_data();
+            sensor_data_t sensor_data;
             
-            if (sensor_data && sensor_data->data_ready) {
+            if (get_sensor_data(&sensor_data) && sensor_data.data_ready) {
                 uint8_t sensor_data_bytes[12];
-                uint8_t* temp_ptr = (uint8_t*)&sensor_data->temperature;
-                uint8_t* hum_ptr = (uint8_t*)&sensor_data->humidity;
-                uint8_t* press_ptr = (uint8_t*)&sensor_data->pressure;
+                uint8_t* temp_ptr = (uint8_t*)&sensor_data.temperature;
+                uint8_t* hum_ptr = (uint8_t*)&sensor_data.humidity;
+                uint8_t* press_ptr = (uint8_t*)&sensor_data.pressure;
                 
                 memcpy(&sensor_data_bytes[0], temp_ptr, 4);
                 memcpy(&sensor_data_bytes[4], hum_ptr, 4);
                 memcpy(&sensor_data_bytes[8], press_ptr, 4);
                 
-                uint16_t tx_len = protocol_create_packet(CMD_SENSOR_DATA, 
-                                                        sensor_data_bytes, 12,
-                                                        tx_buffer, sizeof(tx_buffer),
-                                                        &protocol_handler);
-                if (tx_len > 0) {
-                    hal_uart_send(&comm_uart, tx_buffer, tx_len);
-                    comm_status.packets_sent++;
-                }
+                comm_send_packet(CMD_SENSOR_DATA, sensor_data_bytes, 12);
             }
             break;
         }
@@ -80,14 +106,7 @@ static void process_command(const protocol_packet_t* packet) {
             memcpy(&status_data[4], cpu_ptr, 4);
             status_data[8] = task_count;
             
-            uint16_t tx_len = protocol_create_packet(CMD_STATUS_RESPONSE,
-                                                    status_data, sizeof(status_data),
-                                                    tx_buffer, sizeof(tx_buffer),
-                                                    &protocol_handler);
-            if (tx_len > 0) {
-                hal_uart_send(&comm_uart, tx_buffer, tx_len);
-                comm_status.packets_sent++;
-            }
+            comm_send_packet(CMD_STATUS_RESPONSE, status_data, sizeof(status_data));
             break;
         }
         
@@ -95,28 +114,14 @@ static void process_command(const protocol_packet_t* packet) {
             LOG_INFO("Received START_OTA command");
             // In a real system, this would start OTA process
             uint8_t response[] = {0x01}; // ACK
-            uint16_t tx_len = protocol_create_packet(CMD_OTA_COMPLETE,
-                                                    response, sizeof(response),
-                                                    tx_buffer, sizeof(tx_buffer),
-                                                    &protocol_handler);
-            if (tx_len > 0) {
-                hal_uart_send(&comm_uart, tx_buffer, tx_len);
-                comm_status.packets_sent++;
-            }
+            comm_send_packet(CMD_OTA_COMPLETE, response, sizeof(response));
             break;
         }
         
         default: {
-            LOG_WARN("Unknown command: 0x%02X", packet->command);
+            LOG_WARN_LIMITED(5, 1000, "Unknown command: 0x%02X", packet->command);
             uint8_t error = ERROR_INVALID_CMD;
-            uint16_t tx_len = protocol_create_packet(CMD_ERROR,
-                                                    &error, 1,
-                                                    tx_buffer, sizeof(tx_buffer),
-                                                    &protocol_handler);
-            if (tx_len > 0) {
-                hal_uart_send(&comm_uart, tx_buffer, tx_len);
-                comm_status.packets_sent++;
-            }
+            comm_send_packet(CMD_ERROR, &error, 1);
             break;
         }
     }
@@ -131,12 +136,19 @@ void comm_task(void* arg) {
     memset(&comm_status, 0, sizeof(comm_status));
     comm_status.connected = true;
     
+    mailbox_init(&comm_status_mailbox, &comm_status_shared, sizeof(comm_status_shared));
+    mailbox_write(&comm_status_mailbox, &comm_status);
+    
     // Initialize protocol handler
     protocol_init(&protocol_handler);
     
     // Initialize simulated UART
     hal_uart_init(&comm_uart, 115200);
     
+    if (!bip_buffer_init(&tx_queue, COMM_TX_QUEUE_SIZE)) {
+        LOG_ERROR("Failed to allocate TX queue");
+    }
+    
     uint32_t last_activity_check = 0;
     uint32_t last_stats_print = 0;
     
@@ -154,7 +166,7 @@ void comm_task(void* arg) {
                     process_command(&packet);
                 } else {
                     comm_status.errors++;
-                    LOG_WARN("Failed to parse packet (errors: %u)", comm_status.errors);
+                    LOG_WARN_LIMITED(5, 1000, "Failed to parse packet (errors: %u)", comm_status.errors);
                 }
             }
         }
@@ -163,12 +175,8 @@ void comm_task(void* arg) {
         uint32_t ticks = scheduler_get_tick_count();
         if (ticks - last_activity_check >= 10000) { // Every 10 seconds
             // Simulate sending a heartbeat
-            uint16_t tx_len = protocol_create_ping(tx_buffer, sizeof(tx_buffer), 
-                                                  &protocol_handler);
-            if (tx_len > 0) {
-                hal_uart_send(&comm_uart, tx_buffer, tx_len);
-                comm_status.packets_sent++;
-                
+            const uint8_t ping_data[] = {0x50, 0x49, 0x4E, 0x47}; // "PING"
+            if (comm_send_packet(CMD_PING, ping_data, sizeof(ping_data))) {
                 LOG_DEBUG("Sent heartbeat (total packets sent: %u)", 
                          comm_status.packets_sent);
             }
@@ -186,11 +194,15 @@ void comm_task(void* arg) {
             last_stats_print = ticks;
         }
         
+        comm_flush_tx();
+        
+        mailbox_write(&comm_status_mailbox, &comm_status);
+        
         scheduler_delay(COMM_TASK_PERIOD_MS);
     }
 }
 
 // Getter for communication status
-comm_status_t* get_comm_status(void) {
-    return &comm_status;
+bool get_comm_status(comm_status_t* status) {
+    return mailbox_read(&comm_status_mailbox, status);
 }
\ No newline at end of file
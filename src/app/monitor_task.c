@@ -1,5 +1,7 @@
 #include "tasks.h"
 #include "../kernel/scheduler.h"
+#include "../kernel/mailbox.h"
+#include "../kernel/queue.h"
 #include "../utils/logger.h"
 #include "../ota/ota_manager.h"
 #include <stdio.h>
@@ -7,6 +9,36 @@
 
 // Global system status
 static system_status_t system_status;
+static system_status_t system_status_shared;
+static mailbox_t system_status_mailbox;
+
+// Subscription to the sensor sample stream
+static int sensor_reader = -1;
+static uint32_t stream_samples = 0;
+static float stream_temp_min = 0.0f;
+static float stream_temp_max = 0.0f;
+
+// Drain every sample published since the last pass
+static void consume_sensor_stream(void) {
+    broadcast_ring_t* stream = get_sensor_stream();
+    if (!stream) return;
+    
+    if (sensor_reader < 0) {
+        sensor_reader = broadcast_subscribe(stream);
+        if (sensor_reader < 0) return;
+    }
+    
+    sensor_data_t sample;
+    while (broadcast_consume(stream, sensor_reader, &sample)) {
+        if (stream_samples == 0 || sample.temperature < stream_temp_min) {
+            stream_temp_min = sample.temperature;
+        }
+        if (stream_samples == 0 || sample.temperature > stream_temp_max) {
+            stream_temp_max = sample.temperature;
+        }
+        stream_samples++;
+    }
+}
 
 // Memory tracking (simulated)
 static uint32_t total_memory = 1024 * 256; // 256KB simulated
@@ -42,20 +74,20 @@ static void check_system_health(void) {
         system_status.cpu_usage = cpu_usage;
         
         if (cpu_usage > 90.0f) {
-            LOG_WARN("High CPU usage: %.1f%%", cpu_usage);
+            LOG_WARN_LIMITED(1, 30000, "High CPU usage: %.1f%%", cpu_usage);
         } else if (cpu_usage < 5.0f) {
-            LOG_WARN("Low CPU usage: %.1f%%", cpu_usage);
+            LOG_WARN_LIMITED(1, 30000, "Low CPU usage: %.1f%%", cpu_usage);
         }
         
         // Check memory usage
         float mem_usage = (float)used_memory * 100.0f / total_memory;
         if (mem_usage > 80.0f) {
-            LOG_WARN("High memory usage: %.1f%%", mem_usage);
+            LOG_WARN_LIMITED(1, 30000, "High memory usage: %.1f%%", mem_usage);
         }
         
         // Check task count
         if (scheduler.task_count < 3) {
-            LOG_WARN("Low task count: %u", scheduler.task_count);
+            LOG_WARN_LIMITED(1, 30000, "Low task count: %u", scheduler.task_count);
         }
         
         last_check = ticks;
@@ -82,6 +114,18 @@ static void print_system_status(void) {
             LOG_INFO("  OTA: Update available (restart required)");
         }
         
+        if (sensor_reader >= 0) {
+            LOG_INFO("  Sensor stream: %u samples, %u lost, Temp %.2f..%.2f°C",
+                    stream_samples, broadcast_lost(get_sensor_stream(), sensor_reader),
+                    stream_temp_min, stream_temp_max);
+            stream_samples = 0;
+        }
+        
+        // Health of every live queue in one report
+        if (queue_registry_count() > 0) {
+            queue_print_all_stats();
+        }
+        
         last_print = ticks;
     }
 }
@@ -97,6 +141,8 @@ void monitor_task(void* arg) {
     system_status.task_count = scheduler.task_count;
     system_status.memory_total = total_memory;
     
+    mailbox_init(&system_status_mailbox, &system_status_shared, sizeof(system_status_shared));
+    
     uint32_t startup_time = scheduler_get_tick_count();
     
     while (1) {
@@ -111,15 +157,19 @@ void monitor_task(void* arg) {
         // Check system health
         check_system_health();
         
+        consume_sensor_stream();
+        
         // Print status periodically
         print_system_status();
         
+        mailbox_write(&system_status_mailbox, &system_status);
+        
         // Simulate monitoring overhead
         scheduler_delay(MONITOR_TASK_PERIOD_MS);
     }
 }
 
 // Getter for system status
-system_status_t* get_system_status(void) {
-    return &system_status;
+bool get_system_status(system_status_t* status) {
+    return mailbox_read(&system_status_mailbox, status);
 }
\ No newline at end of file
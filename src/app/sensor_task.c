@@ -1,17 +1,28 @@
 #include "tasks.h"
 #include "../kernel/scheduler.h"
+#include "../kernel/mailbox.h"
+#include "../kernel/broadcast.h"
 #include "../algorithms/kalman_filter.h"
 #include "../utils/logger.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <time.h>
 
-// Global sensor data
+// Working copy owned by the sensor task
 static sensor_data_t sensor_data;
-static kalman1d_t temp_kf;
-static kalman1d_t hum_kf;
-static kalman1d_t press_kf;
+
+// Published snapshot for other tasks
+static sensor_data_t sensor_data_shared;
+static mailbox_t sensor_mailbox;
+
+// Full sample stream fanned out to any number of subscribers
+static broadcast_ring_t* sensor_stream = NULL;
+
+// One filter channel per measured quantity, updated together
+enum { SENSOR_CH_TEMP, SENSOR_CH_HUM, SENSOR_CH_PRESS, SENSOR_CHANNELS };
+static kalman1d_bank_t sensor_kf;
 
 // Initialize random seed
 static void init_random(void) {
@@ -82,10 +93,15 @@ void sensor_task(void* arg) {
     
     init_random();
     
-    // Initialize Kalman filters
-    kalman1d_init(&temp_kf, 0.001f, 0.1f, 25.0f, 1.0f);
-    kalman1d_init(&hum_kf, 0.001f, 0.5f, 50.0f, 1.0f);
-    kalman1d_init(&press_kf, 0.01f, 1.0f, 1013.25f, 1.0f);
+    // Initialize Kalman filters; without them the raw readings are published
+    bool filtering = kalman1d_bank_init(&sensor_kf, SENSOR_CHANNELS);
+    if (filtering) {
+        kalman1d_bank_set_channel(&sensor_kf, SENSOR_CH_TEMP, 0.001f, 0.1f, 25.0f, 1.0f);
+        kalman1d_bank_set_channel(&sensor_kf, SENSOR_CH_HUM, 0.001f, 0.5f, 50.0f, 1.0f);
+        kalman1d_bank_set_channel(&sensor_kf, SENSOR_CH_PRESS, 0.01f, 1.0f, 1013.25f, 1.0f);
+    } else {
+        LOG_ERROR("Sensor filter bank unavailable, publishing unfiltered readings");
+    }
     
     // Initialize sensor data
     memset(&sensor_data, 0, sizeof(sensor_data));
@@ -94,22 +110,38 @@ void sensor_task(void* arg) {
     sensor_data.pressure = 1013.25f;
     sensor_data.data_ready = false;
     
+    mailbox_init(&sensor_mailbox, &sensor_data_shared, sizeof(sensor_data_shared));
+    
+    sensor_stream = broadcast_create(SENSOR_STREAM_CAPACITY, sizeof(sensor_data_t),
+                                     BROADCAST_GATE_OVERWRITE);
+    
     uint32_t last_print = 0;
     
     while (1) {
         // Generate raw sensor readings
-        float raw_temp = simulate_temperature();
-        float raw_hum = simulate_humidity();
-        float raw_press = simulate_pressure();
+        float raw[SENSOR_CHANNELS];
+        raw[SENSOR_CH_TEMP] = simulate_temperature();
+        raw[SENSOR_CH_HUM] = simulate_humidity();
+        raw[SENSOR_CH_PRESS] = simulate_pressure();
         
         // Apply Kalman filtering
-        sensor_data.temperature = kalman1d_update(&temp_kf, raw_temp);
-        sensor_data.humidity = kalman1d_update(&hum_kf, raw_hum);
-        sensor_data.pressure = kalman1d_update(&press_kf, raw_press);
+        float filtered[SENSOR_CHANNELS];
+        if (filtering) {
+            kalman1d_update_batch(&sensor_kf, raw, filtered);
+        } else {
+            memcpy(filtered, raw, sizeof(filtered));
+        }
+        sensor_data.temperature = filtered[SENSOR_CH_TEMP];
+        sensor_data.humidity = filtered[SENSOR_CH_HUM];
+        sensor_data.pressure = filtered[SENSOR_CH_PRESS];
         
         sensor_data.sample_count++;
         sensor_data.data_ready = true;
         
+        // Publish the complete sample in one step
+        mailbox_write(&sensor_mailbox, &sensor_data);
+        broadcast_publish(sensor_stream, &sensor_data);
+        
         // Print sensor data every 100 samples
         if (sensor_data.sample_count % 100 == 0) {
             uint32_t ticks = scheduler_get_tick_count();
@@ -127,6 +159,11 @@ void sensor_task(void* arg) {
 }
 
 // Getter for sensor data
-sensor_data_t* get_sensor_data(void) {
-    return &sensor_data;
+bool get_sensor_data(sensor_data_t* data) {
+    return mailbox_read(&sensor_mailbox, data);
+}
+
+// Getter for the sensor sample stream
+broadcast_ring_t* get_sensor_stream(void) {
+    return sensor_stream;
 }
\ No newline at end of file
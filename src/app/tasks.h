@@ -1,6 +1,10 @@
 #ifndef TASKS_H
 #define TASKS_H
 
+#include <stdint.h>
+#include <stdbool.h>
+#include "../kernel/broadcast.h"
+
 // Task function prototypes
 void sensor_task(void* arg);
 void comm_task(void* arg);
@@ -41,8 +45,18 @@ typedef struct {
 } system_status_t;
 
 // Global data accessors
-sensor_data_t* get_sensor_data(void);
-comm_status_t* get_comm_status(void);
-system_status_t* get_system_status(void);
+// Each copies the latest published snapshot out of a seqlock mailbox, so
+// readers in other threads never see a half-updated structure.
+// Return false until the owning task has published its first value.
+bool get_sensor_data(sensor_data_t* data);
+bool get_comm_status(comm_status_t* status);
+bool get_system_status(system_status_t* status);
+
+// Every filtered sample, in order, for consumers that need the full stream
+// (not just the latest value). Subscribe with broadcast_subscribe();
+// NULL until the sensor task has started. Slow readers lose samples, the
+// sensor task is never blocked.
+#define SENSOR_STREAM_CAPACITY  128
+broadcast_ring_t* get_sensor_stream(void);
 
 #endif
\ No newline at end of file
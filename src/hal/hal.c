@@ -1,5 +1,8 @@
+#define LOG_MODULE LOG_MODULE_HAL
+
 #include "hal.h"
-#include <stdio.h>
+#include "../utils/hex_format.h"
+#include "../utils/logger.h"
 #include <string.h>
 #include <stdlib.h>
 #include <time.h>
@@ -42,14 +45,14 @@ void hal_init(void) {
     system_tick_ms = 0;
     system_tick_us = 0;
     
-    printf("[HAL] Hardware Abstraction Layer Initialized\n");
-    printf("[HAL] Virtual MCU: ARM Cortex-M4 @ 100MHz (simulated)\n");
-    printf("[HAL] Virtual RAM: 256KB, Flash: 1MB\n");
-    printf("[HAL] Virtual Peripherals: GPIO, UART, ADC, TIMER, SPI\n");
+    LOG_INFO("[HAL] Hardware Abstraction Layer Initialized");
+    LOG_INFO("[HAL] Virtual MCU: ARM Cortex-M4 @ 100MHz (simulated)");
+    LOG_INFO("[HAL] Virtual RAM: 256KB, Flash: 1MB");
+    LOG_INFO("[HAL] Virtual Peripherals: GPIO, UART, ADC, TIMER, SPI");
 }
 
 void hal_deinit(void) {
-    printf("[HAL] Hardware Abstraction Layer Deinitialized\n");
+    LOG_INFO("[HAL] Hardware Abstraction Layer Deinitialized");
 }
 
 // GPIO Functions
@@ -57,16 +60,16 @@ void hal_gpio_init(gpio_t* gpio) {
     if (gpio) {
         gpio->value = false;
         gpio->initialized = true;
-        printf("[HAL_GPIO] Initialized GPIO P%c%d (Mode: %d, Pull: %d)\n",
-               'A' + gpio->port, gpio->pin, gpio->mode, gpio->pull);
+        LOG_INFO("[HAL_GPIO] Initialized GPIO P%c%d (Mode: %d, Pull: %d)",
+                 'A' + gpio->port, gpio->pin, gpio->mode, gpio->pull);
     }
 }
 
 void hal_gpio_deinit(gpio_t* gpio) {
     if (gpio && gpio->initialized) {
         gpio->initialized = false;
-        printf("[HAL_GPIO] Deinitialized GPIO P%c%d\n",
-               'A' + gpio->port, gpio->pin);
+        LOG_INFO("[HAL_GPIO] Deinitialized GPIO P%c%d",
+                 'A' + gpio->port, gpio->pin);
     }
 }
 
@@ -74,8 +77,8 @@ void hal_gpio_write(gpio_t* gpio, bool value) {
     if (gpio && gpio->initialized) {
         gpio->value = value;
         if (gpio->mode == GPIO_MODE_OUTPUT) {
-            printf("[HAL_GPIO] P%c%d = %s\n",
-                   'A' + gpio->port, gpio->pin, value ? "HIGH" : "LOW");
+            LOG_DEBUG("[HAL_GPIO] P%c%d = %s",
+                      'A' + gpio->port, gpio->pin, value ? "HIGH" : "LOW");
         }
     }
 }
@@ -91,8 +94,8 @@ bool hal_gpio_read(gpio_t* gpio) {
             bool simulated_value = gpio->value;
             if (counter % 500 == 0) {
                 simulated_value = !simulated_value;
-                printf("[HAL_GPIO] Simulated button press on P%c%d\n",
-                       'A' + gpio->port, gpio->pin);
+                LOG_INFO("[HAL_GPIO] Simulated button press on P%c%d",
+                         'A' + gpio->port, gpio->pin);
             }
             return simulated_value;
         }
@@ -104,8 +107,8 @@ bool hal_gpio_read(gpio_t* gpio) {
 void hal_gpio_toggle(gpio_t* gpio) {
     if (gpio && gpio->initialized) {
         gpio->value = !gpio->value;
-        printf("[HAL_GPIO] Toggled P%c%d to %s\n",
-               'A' + gpio->port, gpio->pin, gpio->value ? "HIGH" : "LOW");
+        LOG_DEBUG("[HAL_GPIO] Toggled P%c%d to %s",
+                  'A' + gpio->port, gpio->pin, gpio->value ? "HIGH" : "LOW");
     }
 }
 
@@ -113,47 +116,38 @@ void hal_gpio_toggle(gpio_t* gpio) {
 void hal_uart_init(uart_t* uart, uint32_t baudrate) {
     if (uart) {
         uart->baudrate = baudrate;
-        uart->rx_head = 0;
-        uart->rx_tail = 0;
+        if (!circular_buffer_init_spsc(&uart->rx_ring, HAL_UART_RX_RING_SIZE)) {
+            LOG_ERROR("[HAL_UART] Failed to allocate RX ring for UART%d", uart->id);
+            uart->initialized = false;
+            return;
+        }
         uart->initialized = true;
-        memset(uart->rx_buffer, 0, sizeof(uart->rx_buffer));
         
-        printf("[HAL_UART] Initialized UART%d @ %u baud\n", 
-               uart->id, baudrate);
+        LOG_INFO("[HAL_UART] Initialized UART%d @ %u baud", 
+                 uart->id, baudrate);
     }
 }
 
 void hal_uart_deinit(uart_t* uart) {
     if (uart && uart->initialized) {
         uart->initialized = false;
-        printf("[HAL_UART] Deinitialized UART%d\n", uart->id);
+        circular_buffer_destroy(&uart->rx_ring);
+        LOG_INFO("[HAL_UART] Deinitialized UART%d", uart->id);
     }
 }
 
 void hal_uart_send(uart_t* uart, const uint8_t* data, uint32_t len) {
     if (uart && uart->initialized && data && len > 0) {
-        printf("[HAL_UART%d] TX [%u bytes]: ", uart->id, len);
+        char hex[32 * 3 + 1];
+        char ascii[32 + 1];
+        uint32_t shown = len < 32 ? len : 32;
         
-        // Print hex and ASCII
-        for (uint32_t i = 0; i < len && i < 32; i++) {
-            if (i % 16 == 0 && i > 0) printf("\n                    ");
-            printf("%02X ", data[i]);
-        }
-        
-        if (len > 32) {
-            printf("... (truncated)");
-        }
+        // Hex and printable ASCII of the first 32 bytes, one line per frame
+        hex[hex_encode(hex, data, shown, true, ' ')] = '\0';
+        ascii[hex_ascii(ascii, data, shown)] = '\0';
         
-        // Print ASCII representation for printable characters
-        printf("\n                    ASCII: ");
-        for (uint32_t i = 0; i < len && i < 32; i++) {
-            if (data[i] >= 32 && data[i] <= 126) {
-                printf("%c", data[i]);
-            } else {
-                printf(".");
-            }
-        }
-        printf("\n");
+        LOG_DEBUG("[HAL_UART%d] TX [%u bytes]: %s%s ASCII: %s",
+                  uart->id, len, hex, len > 32 ? "... " : "", ascii);
     }
 }
 
@@ -162,6 +156,12 @@ uint32_t hal_uart_receive(uart_t* uart, uint8_t* buffer, uint32_t len) {
         return 0;
     }
     
+    // Bytes delivered by the RX ISR take priority over simulated traffic
+    size_t pending = circular_buffer_read(&uart->rx_ring, buffer, len);
+    if (pending > 0) {
+        return (uint32_t)pending;
+    }
+    
     static uint32_t simulation_counter = 0;
     simulation_counter++;
     
@@ -181,8 +181,8 @@ uint32_t hal_uart_receive(uart_t* uart, uint8_t* buffer, uint32_t len) {
         
         memcpy(buffer, message, copy_len);
         
-        printf("[HAL_UART%d] RX [%u bytes]: %.*s\n",
-               uart->id, copy_len, copy_len, buffer);
+        LOG_DEBUG("[HAL_UART%d] RX [%u bytes]: %.*s",
+                  uart->id, copy_len, copy_len, buffer);
         
         return copy_len;
     }
@@ -193,6 +193,8 @@ uint32_t hal_uart_receive(uart_t* uart, uint8_t* buffer, uint32_t len) {
 bool hal_uart_available(uart_t* uart) {
     if (!uart || !uart->initialized) return false;
     
+    if (!circular_buffer_is_empty(&uart->rx_ring)) return true;
+    
     static uint32_t check_counter = 0;
     check_counter++;
     
@@ -202,20 +204,43 @@ bool hal_uart_available(uart_t* uart) {
 
 void hal_uart_flush(uart_t* uart) {
     if (uart && uart->initialized) {
-        uart->rx_head = 0;
-        uart->rx_tail = 0;
-        printf("[HAL_UART%d] Flushed RX buffer\n", uart->id);
+        // Consumer-side discard keeps the ring safe against a running ISR
+        circular_buffer_advance_read(&uart->rx_ring, circular_buffer_size(&uart->rx_ring));
+        LOG_INFO("[HAL_UART%d] Flushed RX buffer", uart->id);
     }
 }
 
+uint32_t hal_uart_rx_isr(uart_t* uart, const uint8_t* data, uint32_t len) {
+    if (!uart || !uart->initialized || !data) {
+        return 0;
+    }
+    
+    // Copy straight into the ring's free space, at most two contiguous spans
+    uint32_t accepted = 0;
+    while (accepted < len) {
+        size_t space = 0;
+        uint8_t* dest = circular_buffer_get_write_ptr(&uart->rx_ring, &space);
+        if (!dest) break; // Overrun: remaining bytes are dropped
+        
+        size_t chunk = len - accepted;
+        if (chunk > space) chunk = space;
+        
+        memcpy(dest, data + accepted, chunk);
+        circular_buffer_advance_write(&uart->rx_ring, chunk);
+        accepted += (uint32_t)chunk;
+    }
+    
+    return accepted;
+}
+
 // ADC Functions
 void hal_adc_init(adc_t* adc, uint32_t resolution) {
     if (adc) {
         adc->resolution = resolution;
         adc->value = 0;
         adc->sample_count = 0;
-        printf("[HAL_ADC] Initialized ADC channel %u (%u-bit)\n",
-               adc->channel, resolution);
+        LOG_INFO("[HAL_ADC] Initialized ADC channel %u (%u-bit)",
+                 adc->channel, resolution);
     }
 }
 
@@ -242,8 +267,8 @@ uint32_t hal_adc_read(adc_t* adc) {
     }
     
     if (adc->sample_count % 200 == 0) {
-        printf("[HAL_ADC] Channel %u: %u (0x%04X) [Samples: %u]\n",
-               adc->channel, adc->value, adc->value, adc->sample_count);
+        LOG_DEBUG("[HAL_ADC] Channel %u: %u (0x%04X) [Samples: %u]",
+                  adc->channel, adc->value, adc->value, adc->sample_count);
     }
     
     return adc->value;
@@ -262,8 +287,8 @@ void hal_timer_init(timer_t* timer, uint32_t prescaler, uint32_t period) {
         timer->period = period;
         timer->counter = 0;
         timer->running = false;
-        printf("[HAL_TIMER] Initialized Timer %u (PSC: %u, ARR: %u)\n",
-               timer->id, prescaler, period);
+        LOG_INFO("[HAL_TIMER] Initialized Timer %u (PSC: %u, ARR: %u)",
+                 timer->id, prescaler, period);
     }
 }
 
@@ -271,14 +296,14 @@ void hal_timer_start(timer_t* timer) {
     if (timer) {
         timer->running = true;
         timer->counter = 0;
-        printf("[HAL_TIMER] Started Timer %u\n", timer->id);
+        LOG_INFO("[HAL_TIMER] Started Timer %u", timer->id);
     }
 }
 
 void hal_timer_stop(timer_t* timer) {
     if (timer) {
         timer->running = false;
-        printf("[HAL_TIMER] Stopped Timer %u\n", timer->id);
+        LOG_INFO("[HAL_TIMER] Stopped Timer %u", timer->id);
     }
 }
 
@@ -290,8 +315,8 @@ uint32_t hal_timer_get_count(timer_t* timer) {
         }
         
         if (timer->counter % 1000 == 0) {
-            printf("[HAL_TIMER] Timer %u count: %u/%u\n",
-                   timer->id, timer->counter, timer->period);
+            LOG_DEBUG("[HAL_TIMER] Timer %u count: %u/%u",
+                      timer->id, timer->counter, timer->period);
         }
         
         return timer->counter;
@@ -302,7 +327,7 @@ uint32_t hal_timer_get_count(timer_t* timer) {
 void hal_timer_reset(timer_t* timer) {
     if (timer) {
         timer->counter = 0;
-        printf("[HAL_TIMER] Reset Timer %u\n", timer->id);
+        LOG_INFO("[HAL_TIMER] Reset Timer %u", timer->id);
     }
 }
 
@@ -334,9 +359,9 @@ uint64_t hal_get_tick_us(void) {
 }
 
 void hal_reset(void) {
-    printf("[HAL] Simulating system reset...\n");
+    LOG_INFO("[HAL] Simulating system reset...");
     system_tick_ms = 0;
     system_tick_us = 0;
     program_start_time = clock();
-    printf("[HAL] System reset complete\n");
+    LOG_INFO("[HAL] System reset complete");
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "../utils/circular_buffer.h"
 
 // GPIO Configuration
 typedef enum {
@@ -30,12 +31,12 @@ typedef struct {
 typedef struct {
     uint32_t id;
     uint32_t baudrate;
-    uint8_t rx_buffer[128];
-    uint32_t rx_head;
-    uint32_t rx_tail;
+    circular_buffer_t rx_ring;  // SPSC: RX ISR produces, task consumes
     bool initialized;
 } uart_t;
 
+#define HAL_UART_RX_RING_SIZE 256
+
 // ADC Configuration
 typedef struct {
     uint32_t channel;
@@ -80,6 +81,9 @@ uint32_t hal_uart_receive(uart_t* uart, uint8_t* buffer, uint32_t len);
 bool hal_uart_available(uart_t* uart);
 void hal_uart_flush(uart_t* uart);
 
+// Feed received bytes into the RX ring (interrupt/driver side, one producer)
+uint32_t hal_uart_rx_isr(uart_t* uart, const uint8_t* data, uint32_t len);
+
 // ADC Functions
 void hal_adc_init(adc_t* adc, uint32_t resolution);
 uint32_t hal_adc_read(adc_t* adc);
@@ -1,5 +1,9 @@
+#define LOG_MODULE LOG_MODULE_HAL
+
 #include "virt_periph.h"
-#include <stdio.h>
+#include "../utils/trace.h"
+#include "../utils/hex_format.h"
+#include "../utils/logger.h"
 #include <string.h>
 #include <time.h>
 
@@ -18,30 +22,29 @@ void virt_spi_init(virt_spi_t* spi, uint32_t speed_hz, uint8_t mode) {
         spi->DR = 0x00;
         spi->initialized = true;
         
-        printf("[VIRT_SPI] Initialized (Speed: %u Hz, Mode: %u)\n", 
-               speed_hz, mode);
+        LOG_INFO("[VIRT_SPI] Initialized (Speed: %u Hz, Mode: %u)", 
+                 speed_hz, mode);
     }
 }
 
 void virt_spi_deinit(virt_spi_t* spi) {
     if (spi && spi->initialized) {
         spi->initialized = false;
-        printf("[VIRT_SPI] Deinitialized\n");
+        LOG_INFO("[VIRT_SPI] Deinitialized");
     }
 }
 
 void virt_spi_transfer(virt_spi_t* spi, const uint8_t* tx_data, 
                        uint8_t* rx_data, uint32_t size) {
     if (!spi || !spi->initialized) {
-        printf("[VIRT_SPI] Error: SPI not initialized\n");
+        LOG_ERROR("[VIRT_SPI] SPI not initialized");
         return;
     }
     
-    printf("[VIRT_SPI] Transfer %u bytes:\n", size);
-    printf("  TX: ");
+    TRACE(TRACE_CAT_HAL, "SPI transfer %u bytes, TX %02X %02X ...", size,
+          tx_data && size > 0 ? tx_data[0] : 0xFF, tx_data && size > 1 ? tx_data[1] : 0xFF);
     
     for (uint32_t i = 0; i < size && i < 16; i++) {
-        printf("%02X ", tx_data ? tx_data[i] : 0xFF);
         if (rx_data) {
             // Echo back transmitted data for simulation
             rx_data[i] = tx_data ? tx_data[i] : 0x00;
@@ -53,12 +56,6 @@ void virt_spi_transfer(virt_spi_t* spi, const uint8_t* tx_data,
         }
     }
     
-    if (size > 16) {
-        printf("... (truncated)");
-    }
-    
-    printf("\n");
-    
     // Simulate transfer time
 #ifdef _WIN32
     Sleep(1);
@@ -84,35 +81,28 @@ void virt_i2c_init(virt_i2c_t* i2c, uint32_t speed_hz) {
         i2c->CR2 = 0x0000;
         i2c->initialized = true;
         
-        printf("[VIRT_I2C] Initialized (Speed: %u Hz)\n", speed_hz);
+        LOG_INFO("[VIRT_I2C] Initialized (Speed: %u Hz)", speed_hz);
     }
 }
 
 void virt_i2c_deinit(virt_i2c_t* i2c) {
     if (i2c && i2c->initialized) {
         i2c->initialized = false;
-        printf("[VIRT_I2C] Deinitialized\n");
+        LOG_INFO("[VIRT_I2C] Deinitialized");
     }
 }
 
 bool virt_i2c_write(virt_i2c_t* i2c, uint8_t dev_addr, 
                     const uint8_t* data, uint32_t len) {
     if (!i2c || !i2c->initialized || !data || len == 0) {
-        printf("[VIRT_I2C] Error: Invalid parameters\n");
+        LOG_ERROR("[VIRT_I2C] Invalid parameters");
         return false;
     }
     
-    printf("[VIRT_I2C] Write to device 0x%02X (%u bytes): ", dev_addr, len);
-    
-    for (uint32_t i = 0; i < len && i < 16; i++) {
-        printf("%02X ", data[i]);
-    }
-    
-    if (len > 16) {
-        printf("... (truncated)");
-    }
-    
-    printf("\n");
+    char hex[16 * 3 + 1];
+    hex[hex_encode(hex, data, len < 16 ? len : 16, true, ' ')] = '\0';
+    LOG_DEBUG("[VIRT_I2C] Write to device 0x%02X (%u bytes): %s%s",
+              dev_addr, len, hex, len > 16 ? "... (truncated)" : "");
     
     // Simulate I2C transfer time
 #ifdef _WIN32
@@ -127,7 +117,7 @@ bool virt_i2c_write(virt_i2c_t* i2c, uint8_t dev_addr,
 bool virt_i2c_read(virt_i2c_t* i2c, uint8_t dev_addr, 
                    uint8_t* data, uint32_t len) {
     if (!i2c || !i2c->initialized || !data || len == 0) {
-        printf("[VIRT_I2C] Error: Invalid parameters\n");
+        LOG_ERROR("[VIRT_I2C] Invalid parameters");
         return false;
     }
     
@@ -138,17 +128,10 @@ bool virt_i2c_read(virt_i2c_t* i2c, uint8_t dev_addr,
         data[i] = simulated_data++;
     }
     
-    printf("[VIRT_I2C] Read from device 0x%02X (%u bytes): ", dev_addr, len);
-    
-    for (uint32_t i = 0; i < len && i < 16; i++) {
-        printf("%02X ", data[i]);
-    }
-    
-    if (len > 16) {
-        printf("... (truncated)");
-    }
-    
-    printf("\n");
+    char hex[16 * 3 + 1];
+    hex[hex_encode(hex, data, len < 16 ? len : 16, true, ' ')] = '\0';
+    LOG_DEBUG("[VIRT_I2C] Read from device 0x%02X (%u bytes): %s%s",
+              dev_addr, len, hex, len > 16 ? "... (truncated)" : "");
     
     // Simulate I2C transfer time
 #ifdef _WIN32
@@ -183,14 +166,14 @@ void virt_dma_init(virt_dma_t* dma) {
             dma->CMAR[i] = 0x00000000;
         }
         
-        printf("[VIRT_DMA] Initialized\n");
+        LOG_INFO("[VIRT_DMA] Initialized");
     }
 }
 
 void virt_dma_deinit(virt_dma_t* dma) {
     if (dma && dma->initialized) {
         dma->initialized = false;
-        printf("[VIRT_DMA] Deinitialized\n");
+        LOG_INFO("[VIRT_DMA] Deinitialized");
     }
 }
 
@@ -198,7 +181,7 @@ void virt_dma_config_channel(virt_dma_t* dma, uint8_t channel,
                              uint32_t src_addr, uint32_t dst_addr, 
                              uint32_t size, uint32_t config) {
     if (!dma || !dma->initialized || channel >= 8) {
-        printf("[VIRT_DMA] Error: Invalid channel or DMA not initialized\n");
+        LOG_ERROR("[VIRT_DMA] Invalid channel or DMA not initialized");
         return;
     }
     
@@ -207,23 +190,20 @@ void virt_dma_config_channel(virt_dma_t* dma, uint8_t channel,
     dma->CPAR[channel] = src_addr;
     dma->CMAR[channel] = dst_addr;
     
-    printf("[VIRT_DMA] Channel %u configured:\n", channel);
-    printf("  Source: 0x%08X\n", src_addr);
-    printf("  Dest:   0x%08X\n", dst_addr);
-    printf("  Size:   %u bytes\n", size);
-    printf("  Config: 0x%08X\n", config);
+    LOG_DEBUG("[VIRT_DMA] Channel %u configured (Source: 0x%08X, Dest: 0x%08X, "
+              "Size: %u bytes, Config: 0x%08X)", channel, src_addr, dst_addr, size, config);
 }
 
 void virt_dma_start(virt_dma_t* dma, uint8_t channel) {
     if (!dma || !dma->initialized || channel >= 8) {
-        printf("[VIRT_DMA] Error: Invalid channel or DMA not initialized\n");
+        LOG_ERROR("[VIRT_DMA] Invalid channel or DMA not initialized");
         return;
     }
     
     dma->CCR[channel] |= 0x00000001; // Enable bit
     
-    printf("[VIRT_DMA] Channel %u started (transferring %u bytes)\n",
-           channel, dma->CNDTR[channel]);
+    LOG_DEBUG("[VIRT_DMA] Channel %u started (transferring %u bytes)",
+              channel, dma->CNDTR[channel]);
     
     // Simulate DMA transfer completion
     dma->CNDTR[channel] = 0;
@@ -235,18 +215,18 @@ void virt_dma_start(virt_dma_t* dma, uint8_t channel) {
     usleep(1000);
 #endif
     
-    printf("[VIRT_DMA] Channel %u transfer complete\n", channel);
+    LOG_DEBUG("[VIRT_DMA] Channel %u transfer complete", channel);
 }
 
 void virt_dma_stop(virt_dma_t* dma, uint8_t channel) {
     if (!dma || !dma->initialized || channel >= 8) {
-        printf("[VIRT_DMA] Error: Invalid channel or DMA not initialized\n");
+        LOG_ERROR("[VIRT_DMA] Invalid channel or DMA not initialized");
         return;
     }
     
     dma->CCR[channel] &= ~0x00000001; // Disable bit
     
-    printf("[VIRT_DMA] Channel %u stopped\n", channel);
+    LOG_DEBUG("[VIRT_DMA] Channel %u stopped", channel);
 }
 
 bool virt_dma_is_busy(virt_dma_t* dma, uint8_t channel) {
@@ -281,29 +261,29 @@ void virt_rtc_init(virt_rtc_t* rtc) {
                   ((local_time->tm_mday / 10) << 4) |
                   (local_time->tm_mday % 10);
         
-        printf("[VIRT_RTC] Initialized\n");
-        printf("[VIRT_RTC] Current time: %02d:%02d:%02d\n",
-               local_time->tm_hour, local_time->tm_min, local_time->tm_sec);
-        printf("[VIRT_RTC] Current date: %04d-%02d-%02d\n",
-               local_time->tm_year + 1900, local_time->tm_mon + 1, local_time->tm_mday);
+        LOG_INFO("[VIRT_RTC] Initialized");
+        LOG_INFO("[VIRT_RTC] Current time: %02d:%02d:%02d",
+                 local_time->tm_hour, local_time->tm_min, local_time->tm_sec);
+        LOG_INFO("[VIRT_RTC] Current date: %04d-%02d-%02d",
+                 local_time->tm_year + 1900, local_time->tm_mon + 1, local_time->tm_mday);
     }
 }
 
 void virt_rtc_deinit(virt_rtc_t* rtc) {
     if (rtc && rtc->initialized) {
         rtc->initialized = false;
-        printf("[VIRT_RTC] Deinitialized\n");
+        LOG_INFO("[VIRT_RTC] Deinitialized");
     }
 }
 
 void virt_rtc_set_time(virt_rtc_t* rtc, uint8_t hour, uint8_t minute, uint8_t second) {
     if (!rtc || !rtc->initialized) {
-        printf("[VIRT_RTC] Error: RTC not initialized\n");
+        LOG_ERROR("[VIRT_RTC] RTC not initialized");
         return;
     }
     
     if (hour > 23 || minute > 59 || second > 59) {
-        printf("[VIRT_RTC] Error: Invalid time values\n");
+        LOG_ERROR("[VIRT_RTC] Invalid time values");
         return;
     }
     
@@ -314,18 +294,18 @@ void virt_rtc_set_time(virt_rtc_t* rtc, uint8_t hour, uint8_t minute, uint8_t se
               ((second / 10) << 4) |
               (second % 10);
     
-    printf("[VIRT_RTC] Time set to: %02u:%02u:%02u\n", hour, minute, second);
+    LOG_INFO("[VIRT_RTC] Time set to: %02u:%02u:%02u", hour, minute, second);
 }
 
 void virt_rtc_set_date(virt_rtc_t* rtc, uint8_t year, uint8_t month, 
                        uint8_t day, uint8_t weekday) {
     if (!rtc || !rtc->initialized) {
-        printf("[VIRT_RTC] Error: RTC not initialized\n");
+        LOG_ERROR("[VIRT_RTC] RTC not initialized");
         return;
     }
     
     if (year > 99 || month > 12 || month < 1 || day > 31 || day < 1 || weekday > 6) {
-        printf("[VIRT_RTC] Error: Invalid date values\n");
+        LOG_ERROR("[VIRT_RTC] Invalid date values");
         return;
     }
     
@@ -336,13 +316,13 @@ void virt_rtc_set_date(virt_rtc_t* rtc, uint8_t year, uint8_t month,
               ((day / 10) << 4) |
               (day % 10);
     
-    printf("[VIRT_RTC] Date set to: 20%02u-%02u-%02u (Weekday: %u)\n",
-           year, month, day, weekday);
+    LOG_INFO("[VIRT_RTC] Date set to: 20%02u-%02u-%02u (Weekday: %u)",
+             year, month, day, weekday);
 }
 
 void virt_rtc_get_time(virt_rtc_t* rtc, uint8_t* hour, uint8_t* minute, uint8_t* second) {
     if (!rtc || !rtc->initialized || !hour || !minute || !second) {
-        printf("[VIRT_RTC] Error: Invalid parameters\n");
+        LOG_ERROR("[VIRT_RTC] Invalid parameters");
         return;
     }
     
@@ -354,7 +334,7 @@ void virt_rtc_get_time(virt_rtc_t* rtc, uint8_t* hour, uint8_t* minute, uint8_t*
 void virt_rtc_get_date(virt_rtc_t* rtc, uint8_t* year, uint8_t* month, 
                        uint8_t* day, uint8_t* weekday) {
     if (!rtc || !rtc->initialized || !year || !month || !day) {
-        printf("[VIRT_RTC] Error: Invalid parameters\n");
+        LOG_ERROR("[VIRT_RTC] Invalid parameters");
         return;
     }
     
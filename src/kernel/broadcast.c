@@ -0,0 +1,191 @@
+#define LOG_MODULE LOG_MODULE_KERNEL
+
+#include "broadcast.h"
+#include "../utils/logger.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Slot sequence stored while a slot is being rewritten. It can never match
+// a sequence a reader expects in that slot because capacity is at least 2.
+#define BROADCAST_SLOT_BUSY(seq) ((seq) + 1u)
+
+broadcast_ring_t* broadcast_create(uint32_t capacity, uint32_t element_size,
+                                   broadcast_policy_t policy) {
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0 || element_size == 0) {
+        LOG_ERROR("[BROADCAST] Capacity must be a power of two >= 2");
+        return NULL;
+    }
+    
+    broadcast_ring_t* ring = (broadcast_ring_t*)malloc(sizeof(broadcast_ring_t));
+    if (!ring) {
+        LOG_ERROR("[BROADCAST] Failed to allocate ring structure");
+        return NULL;
+    }
+    
+    ring->slots = (uint8_t*)malloc((size_t)capacity * element_size);
+    ring->slot_sequence = (atomic_uint*)malloc(capacity * sizeof(atomic_uint));
+    if (!ring->slots || !ring->slot_sequence) {
+        LOG_ERROR("[BROADCAST] Failed to allocate slots");
+        free(ring->slots);
+        free(ring->slot_sequence);
+        free(ring);
+        return NULL;
+    }
+    
+    ring->capacity = capacity;
+    ring->element_size = element_size;
+    ring->policy = policy;
+    ring->published = 0;
+    ring->writer_stalls = 0;
+    atomic_init(&ring->head, 0);
+    
+    // No slot holds a valid sequence yet
+    for (uint32_t i = 0; i < capacity; i++) {
+        atomic_init(&ring->slot_sequence[i], BROADCAST_SLOT_BUSY(i));
+    }
+    
+    for (uint32_t i = 0; i < BROADCAST_MAX_READERS; i++) {
+        atomic_init(&ring->readers[i].cursor, 0);
+        atomic_init(&ring->readers[i].active, false);
+        ring->readers[i].received = 0;
+        ring->readers[i].lost = 0;
+    }
+    
+    LOG_INFO("[BROADCAST] Created ring (capacity: %u, element size: %u, policy: %s)",
+             capacity, element_size,
+             policy == BROADCAST_GATE_SLOWEST ? "slowest" : "overwrite");
+    
+    return ring;
+}
+
+void broadcast_destroy(broadcast_ring_t* ring) {
+    if (ring) {
+        free(ring->slot_sequence);
+        free(ring->slots);
+        free(ring);
+        LOG_INFO("[BROADCAST] Destroyed ring");
+    }
+}
+
+// ==================== WRITER ====================
+bool broadcast_publish(broadcast_ring_t* ring, const void* element) {
+    if (!ring || !element) return false;
+    
+    uint32_t seq = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    
+    if (ring->policy == BROADCAST_GATE_SLOWEST) {
+        // The slot about to be reused must have been consumed by everyone
+        for (uint32_t i = 0; i < BROADCAST_MAX_READERS; i++) {
+            broadcast_reader_t* reader = &ring->readers[i];
+            if (!atomic_load_explicit(&reader->active, memory_order_acquire)) continue;
+            
+            uint32_t cursor = atomic_load_explicit(&reader->cursor, memory_order_acquire);
+            if (seq - cursor >= ring->capacity) {
+                ring->writer_stalls++;
+                return false;
+            }
+        }
+    }
+    
+    uint32_t index = seq & (ring->capacity - 1);
+    atomic_uint* slot_seq = &ring->slot_sequence[index];
+    
+    // Same protocol as the mailbox seqlock: invalidate, copy, publish
+    atomic_store_explicit(slot_seq, BROADCAST_SLOT_BUSY(seq), memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    
+    memcpy(&ring->slots[(size_t)index * ring->element_size], element, ring->element_size);
+    
+    atomic_store_explicit(slot_seq, seq, memory_order_release);
+    atomic_store_explicit(&ring->head, seq + 1, memory_order_release);
+    ring->published++;
+    
+    return true;
+}
+
+// ==================== READERS ====================
+int broadcast_subscribe(broadcast_ring_t* ring) {
+    if (!ring) return -1;
+    
+    for (int i = 0; i < BROADCAST_MAX_READERS; i++) {
+        broadcast_reader_t* reader = &ring->readers[i];
+        if (atomic_load_explicit(&reader->active, memory_order_relaxed)) continue;
+        
+        reader->received = 0;
+        reader->lost = 0;
+        atomic_store_explicit(&reader->cursor,
+                              atomic_load_explicit(&ring->head, memory_order_acquire),
+                              memory_order_relaxed);
+        atomic_store_explicit(&reader->active, true, memory_order_release);
+        return i;
+    }
+    
+    LOG_ERROR("[BROADCAST] No free reader slots");
+    return -1;
+}
+
+void broadcast_unsubscribe(broadcast_ring_t* ring, int reader_id) {
+    if (!ring || reader_id < 0 || reader_id >= BROADCAST_MAX_READERS) return;
+    atomic_store_explicit(&ring->readers[reader_id].active, false, memory_order_release);
+}
+
+bool broadcast_consume(broadcast_ring_t* ring, int reader_id, void* element) {
+    if (!ring || !element || reader_id < 0 || reader_id >= BROADCAST_MAX_READERS) {
+        return false;
+    }
+    
+    broadcast_reader_t* reader = &ring->readers[reader_id];
+    uint32_t cursor = atomic_load_explicit(&reader->cursor, memory_order_relaxed);
+    
+    while (1) {
+        uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        if (head == cursor) {
+            // Caught up; keep any slots skipped as lost so they are not
+            // counted again on the next call
+            atomic_store_explicit(&reader->cursor, cursor, memory_order_release);
+            return false;
+        }
+        
+        // Lapped by the writer: skip to the oldest element still present
+        if (head - cursor > ring->capacity) {
+            reader->lost += head - cursor - ring->capacity;
+            cursor = head - ring->capacity;
+        }
+        
+        uint32_t index = cursor & (ring->capacity - 1);
+        atomic_uint* slot_seq = &ring->slot_sequence[index];
+        
+        uint32_t before = atomic_load_explicit(slot_seq, memory_order_acquire);
+        if (before == cursor) {
+            memcpy(element, &ring->slots[(size_t)index * ring->element_size],
+                   ring->element_size);
+            
+            atomic_thread_fence(memory_order_acquire);
+            uint32_t after = atomic_load_explicit(slot_seq, memory_order_relaxed);
+            if (after == cursor) {
+                reader->received++;
+                atomic_store_explicit(&reader->cursor, cursor + 1, memory_order_release);
+                return true;
+            }
+        }
+        
+        // Slot was recycled while we looked at it
+        reader->lost++;
+        cursor++;
+    }
+}
+
+uint32_t broadcast_pending(broadcast_ring_t* ring, int reader_id) {
+    if (!ring || reader_id < 0 || reader_id >= BROADCAST_MAX_READERS) return 0;
+    
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    uint32_t cursor = atomic_load_explicit(&ring->readers[reader_id].cursor,
+                                           memory_order_relaxed);
+    uint32_t pending = head - cursor;
+    return pending > ring->capacity ? ring->capacity : pending;
+}
+
+uint32_t broadcast_lost(broadcast_ring_t* ring, int reader_id) {
+    if (!ring || reader_id < 0 || reader_id >= BROADCAST_MAX_READERS) return 0;
+    return ring->readers[reader_id].lost;
+}
\ No newline at end of file
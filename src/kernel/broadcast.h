@@ -0,0 +1,58 @@
+#ifndef BROADCAST_H
+#define BROADCAST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define BROADCAST_MAX_READERS 8
+
+// What the writer does when the slowest reader is a full ring behind
+typedef enum {
+    BROADCAST_GATE_SLOWEST,     // Refuse to publish (backpressure)
+    BROADCAST_GATE_OVERWRITE    // Publish anyway; lagging readers count losses
+} broadcast_policy_t;
+
+// Per-reader cursor, written only by that reader
+typedef struct {
+    atomic_uint cursor;         // Sequence of the next element to consume
+    atomic_bool active;
+    uint32_t received;
+    uint32_t lost;
+} broadcast_reader_t;
+
+// Single-writer ring read independently by up to BROADCAST_MAX_READERS
+// consumers. Each element is written once and every subscriber gets its own
+// copy out of the shared slot, so fan-out costs no extra queues.
+//
+// Every slot carries the sequence number it holds. A reader accepts a copy
+// only if that number matches before and after the copy, so with the
+// overwrite policy a slot recycled under a slow reader is detected and
+// counted as lost instead of being returned torn.
+typedef struct {
+    uint8_t* slots;
+    atomic_uint* slot_sequence;
+    uint32_t capacity;          // Power of two
+    uint32_t element_size;
+    broadcast_policy_t policy;
+    atomic_uint head;           // Sequence of the next element to publish
+    broadcast_reader_t readers[BROADCAST_MAX_READERS];
+    uint32_t published;
+    uint32_t writer_stalls;     // Publishes refused by BROADCAST_GATE_SLOWEST
+} broadcast_ring_t;
+
+broadcast_ring_t* broadcast_create(uint32_t capacity, uint32_t element_size,
+                                   broadcast_policy_t policy);
+void broadcast_destroy(broadcast_ring_t* ring);
+
+// Writer side
+bool broadcast_publish(broadcast_ring_t* ring, const void* element);
+
+// Reader side: subscribers start with the next published element
+int broadcast_subscribe(broadcast_ring_t* ring);
+void broadcast_unsubscribe(broadcast_ring_t* ring, int reader_id);
+bool broadcast_consume(broadcast_ring_t* ring, int reader_id, void* element);
+uint32_t broadcast_pending(broadcast_ring_t* ring, int reader_id);
+uint32_t broadcast_lost(broadcast_ring_t* ring, int reader_id);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,63 @@
+#define LOG_MODULE LOG_MODULE_KERNEL
+
+#include "mailbox.h"
+#include "../utils/logger.h"
+#include <string.h>
+
+void mailbox_init(mailbox_t* mb, void* storage, uint32_t size) {
+    if (!mb) return;
+    
+    atomic_init(&mb->sequence, 0);
+    mb->data = storage;
+    mb->size = size;
+    
+    if (storage && size > 0) {
+        memset(storage, 0, size);
+    }
+    
+    LOG_INFO("[MAILBOX] Initialized (size: %u bytes)", size);
+}
+
+void mailbox_write(mailbox_t* mb, const void* value) {
+    if (!mb || !mb->data || !value) return;
+    
+    // Only one writer, so a relaxed load of our own counter is enough
+    unsigned int seq = atomic_load_explicit(&mb->sequence, memory_order_relaxed);
+    
+    // Mark the slot as being written (odd) before touching the payload
+    atomic_store_explicit(&mb->sequence, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    
+    memcpy(mb->data, value, mb->size);
+    
+    // Publish: even again, and the payload is visible to acquiring readers
+    atomic_store_explicit(&mb->sequence, seq + 2, memory_order_release);
+}
+
+bool mailbox_read(mailbox_t* mb, void* value) {
+    if (!mb || !mb->data || !value) return false;
+    
+    unsigned int before;
+    unsigned int after = 0;
+    
+    do {
+        before = atomic_load_explicit(&mb->sequence, memory_order_acquire);
+        if (before & 1u) {
+            continue; // Writer in progress, try again
+        }
+        
+        memcpy(value, mb->data, mb->size);
+        
+        // Make sure the payload copy completes before re-checking the sequence
+        atomic_thread_fence(memory_order_acquire);
+        after = atomic_load_explicit(&mb->sequence, memory_order_relaxed);
+    } while ((before & 1u) || before != after);
+    
+    // Nothing has been published yet
+    return before != 0;
+}
+
+uint32_t mailbox_get_version(mailbox_t* mb) {
+    if (!mb) return 0;
+    return atomic_load_explicit(&mb->sequence, memory_order_acquire) / 2;
+}
\ No newline at end of file
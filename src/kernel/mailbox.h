@@ -0,0 +1,22 @@
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+// Single-writer, many-reader "latest value" mailbox protected by a seqlock.
+// The writer never waits for readers; a reader that overlaps a write simply
+// retries its copy until it observes a stable, even sequence number.
+typedef struct {
+    atomic_uint sequence;   // Odd while a write is in progress
+    void* data;             // Caller-provided storage of 'size' bytes
+    uint32_t size;
+} mailbox_t;
+
+void mailbox_init(mailbox_t* mb, void* storage, uint32_t size);
+void mailbox_write(mailbox_t* mb, const void* value);
+bool mailbox_read(mailbox_t* mb, void* value);
+uint32_t mailbox_get_version(mailbox_t* mb);
+
+#endif
\ No newline at end of file
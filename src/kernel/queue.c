@@ -1,15 +1,62 @@
+#define LOG_MODULE LOG_MODULE_KERNEL
+
 #include "queue.h"
+#include "../utils/logger.h"
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// Registry of live queues for system-wide health reporting
+static queue_t* queue_registry[QUEUE_REGISTRY_SIZE];
+static uint32_t queue_created_total = 0;
+
+// Monotonic microsecond clock used for dwell-time measurement
+static uint64_t queue_now_us(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)(counter.QuadPart * 1000000 / frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+#endif
+}
+
+static void queue_registry_add(queue_t* queue) {
+    for (uint32_t i = 0; i < QUEUE_REGISTRY_SIZE; i++) {
+        if (queue_registry[i] == NULL) {
+            queue_registry[i] = queue;
+            return;
+        }
+    }
+    // Registry full: the queue still works, it just isn't reported
+}
+
+static void queue_registry_remove(queue_t* queue) {
+    for (uint32_t i = 0; i < QUEUE_REGISTRY_SIZE; i++) {
+        if (queue_registry[i] == queue) {
+            queue_registry[i] = NULL;
+            return;
+        }
+    }
+}
 
 queue_t* queue_create(uint32_t capacity, uint32_t element_size) {
     queue_t* queue = (queue_t*)malloc(sizeof(queue_t));
     if (!queue) {
-        printf("[QUEUE] Error: Failed to allocate queue structure\n");
+        LOG_ERROR("[QUEUE] Failed to allocate queue structure");
         return NULL;
     }
     
     queue->buffer = malloc(capacity * element_size);
     if (!queue->buffer) {
-        printf("[QUEUE] Error: Failed to allocate buffer\n");
+        LOG_ERROR("[QUEUE] Failed to allocate buffer");
         free(queue);
         return NULL;
     }
@@ -19,58 +66,88 @@ queue_t* queue_create(uint32_t capacity, uint32_t element_size) {
     queue->head = 0;
     queue->tail = 0;
     queue->count = 0;
+    queue->enqueue_time_us = NULL;
+    memset(&queue->stats, 0, sizeof(queue->stats));
+    snprintf(queue->name, QUEUE_NAME_LEN, "Queue%u", queue_created_total++);
+    
+    queue_registry_add(queue);
     
-    printf("[QUEUE] Created queue (capacity: %u, element size: %u)\n", 
-           capacity, element_size);
+    LOG_INFO("[QUEUE] Created queue (capacity: %u, element size: %u)",
+             capacity, element_size);
     
     return queue;
 }
 
 void queue_destroy(queue_t* queue) {
     if (queue) {
+        queue_registry_remove(queue);
+        free(queue->enqueue_time_us);
         free(queue->buffer);
         free(queue);
-        printf("[QUEUE] Destroyed queue\n");
+        LOG_INFO("[QUEUE] Destroyed queue");
     }
 }
 
 bool queue_enqueue(queue_t* queue, const void* element) {
     if (!queue) {
-        printf("[QUEUE] Error: Queue is NULL\n");
+        LOG_ERROR("[QUEUE] Queue is NULL");
         return false;
     }
     
     if (queue_is_full(queue)) {
-        printf("[QUEUE] Warning: Queue is full (capacity: %u)\n", queue->capacity);
+        // Counted, not printed: this is the overload path
+        queue->stats.full_drops++;
         return false;
     }
     
     void* dest = (uint8_t*)queue->buffer + (queue->tail * queue->element_size);
     memcpy(dest, element, queue->element_size);
     
+    if (queue->enqueue_time_us) {
+        queue->enqueue_time_us[queue->tail] = queue_now_us();
+    }
+    
     queue->tail = (queue->tail + 1) % queue->capacity;
     queue->count++;
     
+    queue->stats.enqueued++;
+    if (queue->count > queue->stats.high_water) {
+        queue->stats.high_water = queue->count;
+    }
+    
     return true;
 }
 
 bool queue_dequeue(queue_t* queue, void* element) {
     if (!queue) {
-        printf("[QUEUE] Error: Queue is NULL\n");
+        LOG_ERROR("[QUEUE] Queue is NULL");
         return false;
     }
     
     if (queue_is_empty(queue)) {
-        printf("[QUEUE] Warning: Queue is empty\n");
+        queue->stats.empty_misses++;
         return false;
     }
     
     void* src = (uint8_t*)queue->buffer + (queue->head * queue->element_size);
     memcpy(element, src, queue->element_size);
     
+    if (queue->enqueue_time_us) {
+        uint64_t dwell = queue_now_us() - queue->enqueue_time_us[queue->head];
+        uint32_t dwell_us = dwell > UINT32_MAX ? UINT32_MAX : (uint32_t)dwell;
+        
+        queue->stats.dwell_total_us += dwell_us;
+        queue->stats.dwell_samples++;
+        if (dwell_us > queue->stats.dwell_max_us) {
+            queue->stats.dwell_max_us = dwell_us;
+        }
+    }
+    
     queue->head = (queue->head + 1) % queue->capacity;
     queue->count--;
     
+    queue->stats.dequeued++;
+    
     return true;
 }
 
@@ -102,6 +179,97 @@ void queue_clear(queue_t* queue) {
         queue->head = 0;
         queue->tail = 0;
         queue->count = 0;
-        printf("[QUEUE] Cleared queue\n");
+        LOG_INFO("[QUEUE] Cleared queue");
+    }
+}
+
+// ==================== INSTRUMENTATION ====================
+void queue_set_name(queue_t* queue, const char* name) {
+    if (!queue || !name) return;
+    
+    strncpy(queue->name, name, QUEUE_NAME_LEN - 1);
+    queue->name[QUEUE_NAME_LEN - 1] = '\0';
+}
+
+bool queue_enable_dwell_tracking(queue_t* queue, bool enable) {
+    if (!queue) return false;
+    
+    if (!enable) {
+        free(queue->enqueue_time_us);
+        queue->enqueue_time_us = NULL;
+        return true;
     }
+    
+    if (queue->enqueue_time_us) {
+        return true; // Already enabled
+    }
+    
+    queue->enqueue_time_us = (uint64_t*)malloc(queue->capacity * sizeof(uint64_t));
+    if (!queue->enqueue_time_us) {
+        LOG_ERROR("[QUEUE] Failed to allocate dwell timestamps");
+        return false;
+    }
+    
+    // Elements already queued are timed from now
+    uint64_t now = queue_now_us();
+    for (uint32_t i = 0; i < queue->capacity; i++) {
+        queue->enqueue_time_us[i] = now;
+    }
+    
+    return true;
+}
+
+void queue_get_stats(queue_t* queue, queue_stats_t* stats) {
+    if (!queue || !stats) return;
+    memcpy(stats, &queue->stats, sizeof(queue_stats_t));
+}
+
+void queue_reset_stats(queue_t* queue) {
+    if (queue) {
+        memset(&queue->stats, 0, sizeof(queue->stats));
+        // Keep the current fill level as the new baseline
+        queue->stats.high_water = queue->count;
+    }
+}
+
+uint32_t queue_registry_count(void) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < QUEUE_REGISTRY_SIZE; i++) {
+        if (queue_registry[i]) count++;
+    }
+    return count;
+}
+
+queue_t* queue_registry_get(uint32_t index) {
+    for (uint32_t i = 0; i < QUEUE_REGISTRY_SIZE; i++) {
+        if (queue_registry[i]) {
+            if (index == 0) return queue_registry[i];
+            index--;
+        }
+    }
+    return NULL;
+}
+
+void queue_print_all_stats(void) {
+    printf("\n╔══════════════════════════════════════════════════════╗\n");
+    printf("║                 QUEUE STATISTICS                     ║\n");
+    printf("╠══════════════════════════════════════════════════════╣\n");
+    printf("║ %-12s %5s %5s %6s %6s %6s %6s ║\n",
+           "Queue", "Fill", "HWM", "Drops", "Miss", "AvgUs", "MaxUs");
+    printf("╠══════════════════════════════════════════════════════╣\n");
+    
+    for (uint32_t i = 0; i < QUEUE_REGISTRY_SIZE; i++) {
+        queue_t* queue = queue_registry[i];
+        if (!queue) continue;
+        
+        const queue_stats_t* s = &queue->stats;
+        uint32_t avg_us = s->dwell_samples > 0 ?
+                          (uint32_t)(s->dwell_total_us / s->dwell_samples) : 0;
+        
+        printf("║ %-12s %2u/%-2u %5u %6u %6u %6u %6u ║\n",
+               queue->name, queue->count, queue->capacity, s->high_water,
+               s->full_drops, s->empty_misses, avg_us, s->dwell_max_us);
+    }
+    
+    printf("╚══════════════════════════════════════════════════════╝\n");
 }
\ No newline at end of file
@@ -6,6 +6,21 @@
 #include <stdlib.h>
 #include <string.h>
 
+#define QUEUE_NAME_LEN          16
+#define QUEUE_REGISTRY_SIZE     16
+
+// Per-queue health counters
+typedef struct {
+    uint32_t enqueued;          // Successful enqueues
+    uint32_t dequeued;          // Successful dequeues
+    uint32_t high_water;        // Highest fill level seen
+    uint32_t full_drops;        // Enqueues rejected because the queue was full
+    uint32_t empty_misses;      // Dequeues attempted on an empty queue
+    uint32_t dwell_max_us;      // Longest time an element spent queued
+    uint64_t dwell_total_us;    // Sum of dwell times (dwell tracking only)
+    uint32_t dwell_samples;     // Elements measured for dwell time
+} queue_stats_t;
+
 typedef struct {
     void* buffer;
     uint32_t capacity;
@@ -13,6 +28,9 @@ typedef struct {
     uint32_t head;
     uint32_t tail;
     uint32_t count;
+    char name[QUEUE_NAME_LEN];
+    queue_stats_t stats;
+    uint64_t* enqueue_time_us;  // Per-slot timestamps, NULL unless dwell tracking is on
 } queue_t;
 
 queue_t* queue_create(uint32_t capacity, uint32_t element_size);
@@ -25,4 +43,15 @@ bool queue_is_empty(queue_t* queue);
 bool queue_is_full(queue_t* queue);
 void queue_clear(queue_t* queue);
 
+// Instrumentation
+void queue_set_name(queue_t* queue, const char* name);
+bool queue_enable_dwell_tracking(queue_t* queue, bool enable);
+void queue_get_stats(queue_t* queue, queue_stats_t* stats);
+void queue_reset_stats(queue_t* queue);
+
+// Registry of live queues (populated by queue_create)
+uint32_t queue_registry_count(void);
+queue_t* queue_registry_get(uint32_t index);
+void queue_print_all_stats(void);
+
 #endif
\ No newline at end of file
@@ -1,4 +1,7 @@
+#define LOG_MODULE LOG_MODULE_KERNEL
+
 #include "scheduler.h"
+#include "../utils/logger.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -26,7 +29,7 @@ void sleep_ms(int ms) {
 void scheduler_init(void) {
     memset(&scheduler, 0, sizeof(scheduler));
     sys_time_ms = 0;
-    printf("[SCHEDULER] Initialized\n");
+    LOG_INFO("[SCHEDULER] Initialized");
 }
 
 static task_t* find_highest_priority_task(void) {
@@ -82,13 +85,13 @@ void scheduler_tick(void) {
 bool scheduler_add_task(void (*func)(void*), void* arg, uint32_t priority, 
                         uint32_t period_ms, const char* name) {
     if (scheduler.task_count >= MAX_TASKS) {
-        printf("[SCHEDULER] Error: Max tasks reached (%d)\n", MAX_TASKS);
+        LOG_ERROR("[SCHEDULER] Max tasks reached (%d)", MAX_TASKS);
         return false;
     }
     
     task_t* task = (task_t*)malloc(sizeof(task_t));
     if (!task) {
-        printf("[SCHEDULER] Error: Memory allocation failed\n");
+        LOG_ERROR("[SCHEDULER] Memory allocation failed");
         return false;
     }
     
@@ -110,8 +113,8 @@ bool scheduler_add_task(void (*func)(void*), void* arg, uint32_t priority,
     }
     
     scheduler.tasks[scheduler.task_count++] = task;
-    printf("[SCHEDULER] Task added: %s (Priority: %u, Period: %ums)\n", 
-           task->name, task->priority, task->period_ms);
+    LOG_INFO("[SCHEDULER] Task added: %s (Priority: %u, Period: %ums)", 
+             task->name, task->priority, task->period_ms);
     return true;
 }
 
@@ -128,7 +131,7 @@ void scheduler_yield(void) {
 
 void scheduler_start(void) {
     scheduler.running = true;
-    printf("[SCHEDULER] Started with %d tasks\n", scheduler.task_count);
+    LOG_INFO("[SCHEDULER] Started with %d tasks", scheduler.task_count);
     
     while (scheduler.running) {
         scheduler_tick();
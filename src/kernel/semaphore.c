@@ -1,4 +1,8 @@
+#define LOG_MODULE LOG_MODULE_KERNEL
+
 #include "semaphore.h"
+#include "../utils/trace.h"
+#include "../utils/logger.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -9,18 +13,18 @@
 void semaphore_init(semaphore_t* sem, uint32_t initial_count, uint32_t max_count) {
     sem->count = initial_count;
     sem->max_count = max_count;
-    printf("[SEMAPHORE] Initialized (count: %u, max: %u)\n", initial_count, max_count);
+    LOG_INFO("[SEMAPHORE] Initialized (count: %u, max: %u)", initial_count, max_count);
 }
 
 bool semaphore_take(semaphore_t* sem, uint32_t timeout_ms) {
     if (!sem) {
-        printf("[SEMAPHORE] Error: Semaphore is NULL\n");
+        LOG_ERROR("[SEMAPHORE] Semaphore is NULL");
         return false;
     }
     
     if (sem->count > 0) {
         sem->count--;
-        printf("[SEMAPHORE] Taken (count now: %u)\n", sem->count);
+        TRACE(TRACE_CAT_KERNEL, "Semaphore taken (count now: %u)", sem->count);
         return true;
     }
     
@@ -32,23 +36,23 @@ bool semaphore_take(semaphore_t* sem, uint32_t timeout_ms) {
 #endif
     }
     
-    printf("[SEMAPHORE] Failed to take (count: %u)\n", sem->count);
+    TRACE(TRACE_CAT_KERNEL, "Semaphore take failed (count: %u)", sem->count);
     return false;
 }
 
 bool semaphore_give(semaphore_t* sem) {
     if (!sem) {
-        printf("[SEMAPHORE] Error: Semaphore is NULL\n");
+        LOG_ERROR("[SEMAPHORE] Semaphore is NULL");
         return false;
     }
     
     if (sem->count < sem->max_count) {
         sem->count++;
-        printf("[SEMAPHORE] Given (count now: %u)\n", sem->count);
+        TRACE(TRACE_CAT_KERNEL, "Semaphore given (count now: %u)", sem->count);
         return true;
     }
     
-    printf("[SEMAPHORE] Failed to give (max count reached: %u)\n", sem->max_count);
+    TRACE(TRACE_CAT_KERNEL, "Semaphore give failed (max count reached: %u)", sem->max_count);
     return false;
 }
 
@@ -1,4 +1,8 @@
+#define LOG_MODULE LOG_MODULE_OTA
+
 #include "bootloader.h"
+#include "../utils/trace.h"
+#include "../utils/logger.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -59,14 +63,14 @@ void bootloader_init(void) {
     // Load active header
     memcpy(&bootloader_ctx.active_header, &flash_memory[APP_SLOT_A_ADDRESS], sizeof(firmware_header_t));
     
-    printf("[BOOTLOADER] Initialized\n");
-    printf("[BOOTLOADER] Active slot: 0x%08X\n", bootloader_ctx.active_slot);
-    printf("[BOOTLOADER] Update slot: 0x%08X\n", bootloader_ctx.update_slot);
-    printf("[BOOTLOADER] Boot count: %u\n", bootloader_ctx.boot_count);
+    LOG_INFO("[BOOTLOADER] Initialized");
+    LOG_INFO("[BOOTLOADER] Active slot: 0x%08X", bootloader_ctx.active_slot);
+    LOG_INFO("[BOOTLOADER] Update slot: 0x%08X", bootloader_ctx.update_slot);
+    LOG_INFO("[BOOTLOADER] Boot count: %u", bootloader_ctx.boot_count);
 }
 
 bootloader_error_t bootloader_check_update(void) {
-    printf("[BOOTLOADER] Checking for updates...\n");
+    LOG_INFO("[BOOTLOADER] Checking for updates...");
     
     bootloader_ctx.state = BOOT_STATE_CHECK_UPDATE;
     
@@ -87,25 +91,23 @@ bootloader_error_t bootloader_check_update(void) {
                                   bootloader_ctx.update_header.version_patch;
         
         if (update_version > current_version) {
-            printf("[BOOTLOADER] Update available!\n");
-            printf("  Current: v%u.%u.%u\n", 
-                   bootloader_ctx.active_header.version_major,
-                   bootloader_ctx.active_header.version_minor,
-                   bootloader_ctx.active_header.version_patch);
-            printf("  Update:  v%u.%u.%u\n",
-                   bootloader_ctx.update_header.version_major,
-                   bootloader_ctx.update_header.version_minor,
-                   bootloader_ctx.update_header.version_patch);
+            LOG_INFO("[BOOTLOADER] Update available! (Current: v%u.%u.%u, Update: v%u.%u.%u)",
+                     bootloader_ctx.active_header.version_major,
+                     bootloader_ctx.active_header.version_minor,
+                     bootloader_ctx.active_header.version_patch,
+                     bootloader_ctx.update_header.version_major,
+                     bootloader_ctx.update_header.version_minor,
+                     bootloader_ctx.update_header.version_patch);
             
             bootloader_ctx.update_pending = true;
             return BOOT_OK;
         } else {
-            printf("[BOOTLOADER] No newer update available\n");
+            LOG_INFO("[BOOTLOADER] No newer update available");
             bootloader_ctx.update_pending = false;
             return BOOT_OK;
         }
     } else {
-        printf("[BOOTLOADER] No valid update found\n");
+        LOG_INFO("[BOOTLOADER] No valid update found");
         bootloader_ctx.update_pending = false;
         return error;
     }
@@ -121,14 +123,14 @@ bootloader_error_t bootloader_validate_firmware(uint32_t address) {
     
     // Check magic number
     if (header.magic != FIRMWARE_MAGIC) {
-        printf("[BOOTLOADER] Invalid magic: 0x%08X (expected: 0x%08X)\n",
-               header.magic, FIRMWARE_MAGIC);
+        LOG_WARN("[BOOTLOADER] Invalid magic: 0x%08X (expected: 0x%08X)",
+                 header.magic, FIRMWARE_MAGIC);
         return BOOT_ERROR_MAGIC_MISMATCH;
     }
     
     // Check size
     if (header.size == 0 || header.size > FLASH_TOTAL_SIZE - address) {
-        printf("[BOOTLOADER] Invalid size: %u\n", header.size);
+        LOG_WARN("[BOOTLOADER] Invalid size: %u", header.size);
         return BOOT_ERROR_INVALID_SIZE;
     }
     
@@ -137,29 +139,26 @@ bootloader_error_t bootloader_validate_firmware(uint32_t address) {
                                              header.size - sizeof(firmware_header_t));
     
     if (calculated_crc != header.crc32) {
-        printf("[BOOTLOADER] CRC mismatch: calculated=0x%08X, stored=0x%08X\n",
-               calculated_crc, header.crc32);
+        LOG_WARN("[BOOTLOADER] CRC mismatch: calculated=0x%08X, stored=0x%08X",
+                 calculated_crc, header.crc32);
         return BOOT_ERROR_CRC_MISMATCH;
     }
     
-    printf("[BOOTLOADER] Firmware at 0x%08X is valid\n", address);
-    printf("  Version: v%u.%u.%u (%s)\n",
-           header.version_major, header.version_minor, header.version_patch,
-           header.version_string);
-    printf("  Size: %u bytes\n", header.size);
-    printf("  CRC32: 0x%08X ✓\n", header.crc32);
-    printf("  Entry point: 0x%08X\n", header.entry_point);
+    LOG_INFO("[BOOTLOADER] Firmware at 0x%08X is valid (Version: v%u.%u.%u (%s), "
+             "Size: %u bytes, CRC32: 0x%08X, Entry point: 0x%08X)",
+             address, header.version_major, header.version_minor, header.version_patch,
+             header.version_string, header.size, header.crc32, header.entry_point);
     
     return BOOT_OK;
 }
 
 bootloader_error_t bootloader_switch_to_update(void) {
     if (!bootloader_ctx.update_pending) {
-        printf("[BOOTLOADER] No update pending\n");
+        LOG_INFO("[BOOTLOADER] No update pending");
         return BOOT_ERROR_NO_APP;
     }
     
-    printf("[BOOTLOADER] Switching to update...\n");
+    LOG_INFO("[BOOTLOADER] Switching to update...");
     bootloader_ctx.state = BOOT_STATE_UPDATE_IN_PROGRESS;
     
     // Validate update firmware
@@ -167,7 +166,7 @@ bootloader_error_t bootloader_switch_to_update(void) {
     if (error != BOOT_OK) {
         bootloader_ctx.last_error = error;
         bootloader_ctx.state = BOOT_STATE_ERROR;
-        printf("[BOOTLOADER] Update validation failed: %d\n", error);
+        LOG_ERROR("[BOOTLOADER] Update validation failed: %d", error);
         return error;
     }
     
@@ -178,20 +177,20 @@ bootloader_error_t bootloader_switch_to_update(void) {
     bootloader_ctx.update_pending = false;
     bootloader_ctx.boot_count++;
     
-    printf("[BOOTLOADER] Successfully switched to update!\n");
-    printf("[BOOTLOADER] New active slot: 0x%08X\n", bootloader_ctx.active_slot);
-    printf("[BOOTLOADER] New version: %s\n", bootloader_ctx.active_header.version_string);
+    LOG_INFO("[BOOTLOADER] Successfully switched to update!");
+    LOG_INFO("[BOOTLOADER] New active slot: 0x%08X", bootloader_ctx.active_slot);
+    LOG_INFO("[BOOTLOADER] New version: %s", bootloader_ctx.active_header.version_string);
     
     return BOOT_OK;
 }
 
 bootloader_error_t bootloader_rollback(void) {
-    printf("[BOOTLOADER] Rolling back to previous version...\n");
+    LOG_INFO("[BOOTLOADER] Rolling back to previous version...");
     
     // Validate slot A firmware
     bootloader_error_t error = bootloader_validate_firmware(APP_SLOT_A_ADDRESS);
     if (error != BOOT_OK) {
-        printf("[BOOTLOADER] Rollback validation failed: %d\n", error);
+        LOG_ERROR("[BOOTLOADER] Rollback validation failed: %d", error);
         return error;
     }
     
@@ -202,30 +201,30 @@ bootloader_error_t bootloader_rollback(void) {
     bootloader_ctx.rollback_requested = true;
     bootloader_ctx.boot_count++;
     
-    printf("[BOOTLOADER] Rollback successful!\n");
-    printf("[BOOTLOADER] Active slot: 0x%08X\n", bootloader_ctx.active_slot);
-    printf("[BOOTLOADER] Version: %s\n", bootloader_ctx.active_header.version_string);
+    LOG_INFO("[BOOTLOADER] Rollback successful!");
+    LOG_INFO("[BOOTLOADER] Active slot: 0x%08X", bootloader_ctx.active_slot);
+    LOG_INFO("[BOOTLOADER] Version: %s", bootloader_ctx.active_header.version_string);
     
     return BOOT_OK;
 }
 
 void bootloader_jump_to_app(uint32_t address) {
-    printf("[BOOTLOADER] Jumping to application at 0x%08X\n", address);
+    LOG_INFO("[BOOTLOADER] Jumping to application at 0x%08X", address);
     
     if (address == APP_SLOT_A_ADDRESS) {
-        printf("[BOOTLOADER] Starting Application Slot A (v1.0.0)\n");
+        LOG_INFO("[BOOTLOADER] Starting Application Slot A (v1.0.0)");
     } else if (address == APP_SLOT_B_ADDRESS) {
-        printf("[BOOTLOADER] Starting Application Slot B (v1.1.0)\n");
+        LOG_INFO("[BOOTLOADER] Starting Application Slot B (v1.1.0)");
     } else {
-        printf("[BOOTLOADER] Error: Invalid application address\n");
+        LOG_ERROR("[BOOTLOADER] Invalid application address");
         return;
     }
     
     // In a real system, this would set the stack pointer and jump
     // For simulation, we just print the action
-    printf("[BOOTLOADER] Setting SP = 0x%08X\n", flash_read_word(address));
-    printf("[BOOTLOADER] Setting PC = 0x%08X\n", flash_read_word(address + 4));
-    printf("[BOOTLOADER] Application started!\n");
+    LOG_INFO("[BOOTLOADER] Setting SP = 0x%08X", flash_read_word(address));
+    LOG_INFO("[BOOTLOADER] Setting PC = 0x%08X", flash_read_word(address + 4));
+    LOG_INFO("[BOOTLOADER] Application started!");
     
     bootloader_ctx.state = BOOT_STATE_JUMP_TO_APP;
 }
@@ -288,11 +287,9 @@ bootloader_error_t flash_erase_page(uint32_t address) {
     
     uint32_t page_start = address & ~(FLASH_PAGE_SIZE - 1);
     
-    printf("[FLASH] Erasing page at 0x%08X...\n", page_start);
-    
     memset(&flash_memory[page_start], 0xFF, FLASH_PAGE_SIZE);
     
-    printf("[FLASH] Page erased successfully\n");
+    TRACE(TRACE_CAT_FLASH, "Erased page at 0x%08X", page_start);
     return BOOT_OK;
 }
 
@@ -301,13 +298,11 @@ bootloader_error_t flash_write_word(uint32_t address, uint32_t data) {
         return BOOT_ERROR_FLASH_WRITE;
     }
     
-    printf("[FLASH] Writing 0x%08X to 0x%08X\n", data, address);
-    
     // Check if location is erased (all 0xFF)
     for (int i = 0; i < 4; i++) {
         if (flash_memory[address + i] != 0xFF) {
-            printf("[FLASH] Error: Location not erased (0x%02X at 0x%08X)\n",
-                   flash_memory[address + i], address + i);
+            LOG_ERROR("[FLASH] Location not erased (0x%02X at 0x%08X)",
+                      flash_memory[address + i], address + i);
             return BOOT_ERROR_FLASH_WRITE;
         }
     }
@@ -318,7 +313,7 @@ bootloader_error_t flash_write_word(uint32_t address, uint32_t data) {
     flash_memory[address + 2] = (data >> 16) & 0xFF;
     flash_memory[address + 3] = (data >> 24) & 0xFF;
     
-    printf("[FLASH] Write successful\n");
+    TRACE(TRACE_CAT_FLASH, "Wrote 0x%08X to 0x%08X", data, address);
     return BOOT_OK;
 }
 
@@ -338,7 +333,7 @@ uint32_t flash_read_word(uint32_t address) {
 void flash_dump(uint32_t address, uint32_t size) {
     if (address >= FLASH_TOTAL_SIZE || size == 0 || 
         address + size > FLASH_TOTAL_SIZE) {
-        printf("[FLASH] Invalid dump parameters\n");
+        LOG_ERROR("[FLASH] Invalid dump parameters");
         return;
     }
     
@@ -1,4 +1,7 @@
+#define LOG_MODULE LOG_MODULE_OTA
+
 #include "ota_manager.h"
+#include "../utils/logger.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -40,11 +43,12 @@ static void update_state(ota_state_t new_state, ota_error_t error) {
         status_callback(new_state, error);
     }
     
-    printf("[OTA_MANAGER] State changed to: %s", ota_manager_state_to_string(new_state));
     if (error != OTA_ERROR_NONE) {
-        printf(" (Error: %s)", ota_manager_error_to_string(error));
+        LOG_WARN("[OTA_MANAGER] State changed to: %s (Error: %s)",
+                 ota_manager_state_to_string(new_state), ota_manager_error_to_string(error));
+    } else {
+        LOG_INFO("[OTA_MANAGER] State changed to: %s", ota_manager_state_to_string(new_state));
     }
-    printf("\n");
 }
 
 void ota_manager_init(void) {
@@ -56,24 +60,24 @@ void ota_manager_init(void) {
     ota_ctx.timeout_ms = 30000; // 30 second timeout
     ota_ctx.progress_percent = 0;
     
-    printf("[OTA_MANAGER] Initialized\n");
-    printf("[OTA_MANAGER] Update address: 0x%08X\n", ota_ctx.update_address);
-    printf("[OTA_MANAGER] Timeout: %u ms\n", ota_ctx.timeout_ms);
+    LOG_INFO("[OTA_MANAGER] Initialized");
+    LOG_INFO("[OTA_MANAGER] Update address: 0x%08X", ota_ctx.update_address);
+    LOG_INFO("[OTA_MANAGER] Timeout: %u ms", ota_ctx.timeout_ms);
 }
 
 ota_error_t ota_manager_start_update(uint32_t total_size, uint32_t chunk_size) {
     if (ota_ctx.state != OTA_STATE_IDLE) {
-        printf("[OTA_MANAGER] Error: Cannot start update, manager is not idle\n");
+        LOG_ERROR("[OTA_MANAGER] Cannot start update, manager is not idle");
         return OTA_ERROR_INVALID_STATE;
     }
     
     if (total_size == 0 || chunk_size == 0 || chunk_size > 1024) {
-        printf("[OTA_MANAGER] Error: Invalid size parameters\n");
+        LOG_ERROR("[OTA_MANAGER] Invalid size parameters");
         return OTA_ERROR_INVALID_SIZE;
     }
     
     if (total_size > (FLASH_TOTAL_SIZE - APP_SLOT_B_ADDRESS)) {
-        printf("[OTA_MANAGER] Error: Firmware too large\n");
+        LOG_ERROR("[OTA_MANAGER] Firmware too large");
         return OTA_ERROR_INVALID_SIZE;
     }
     
@@ -91,10 +95,10 @@ ota_error_t ota_manager_start_update(uint32_t total_size, uint32_t chunk_size) {
     ota_ctx.restart_required = false;
     
     // Erase the update area
-    printf("[OTA_MANAGER] Erasing update area...\n");
+    LOG_INFO("[OTA_MANAGER] Erasing update area...");
     bootloader_error_t boot_error = flash_erase_page(APP_SLOT_B_ADDRESS);
     if (boot_error != BOOT_OK) {
-        printf("[OTA_MANAGER] Error: Failed to erase flash\n");
+        LOG_ERROR("[OTA_MANAGER] Failed to erase flash");
         update_state(OTA_STATE_ERROR, OTA_ERROR_FLASH_ERROR);
         return OTA_ERROR_FLASH_ERROR;
     }
@@ -103,11 +107,9 @@ ota_error_t ota_manager_start_update(uint32_t total_size, uint32_t chunk_size) {
     update_state(OTA_STATE_WAITING_FOR_START, OTA_ERROR_NONE);
     update_progress(0);
     
-    printf("[OTA_MANAGER] Update started\n");
-    printf("  Total size: %u bytes\n", total_size);
-    printf("  Chunk size: %u bytes\n", chunk_size);
-    printf("  Total chunks: %u\n", ota_ctx.chunk_info.total_chunks);
-    printf("  Target address: 0x%08X\n", APP_SLOT_B_ADDRESS);
+    LOG_INFO("[OTA_MANAGER] Update started (Total size: %u bytes, Chunk size: %u bytes, "
+             "Total chunks: %u, Target address: 0x%08X)",
+             total_size, chunk_size, ota_ctx.chunk_info.total_chunks, APP_SLOT_B_ADDRESS);
     
     return OTA_ERROR_NONE;
 }
@@ -115,23 +117,23 @@ ota_error_t ota_manager_start_update(uint32_t total_size, uint32_t chunk_size) {
 ota_error_t ota_manager_receive_chunk(uint32_t chunk_number, const uint8_t* data, uint32_t size) {
     if (ota_ctx.state != OTA_STATE_WAITING_FOR_START && 
         ota_ctx.state != OTA_STATE_RECEIVING_DATA) {
-        printf("[OTA_MANAGER] Error: Not ready to receive data\n");
+        LOG_ERROR("[OTA_MANAGER] Not ready to receive data");
         return OTA_ERROR_INVALID_STATE;
     }
     
     if (chunk_number != ota_ctx.chunk_info.next_expected_chunk) {
-        printf("[OTA_MANAGER] Error: Unexpected chunk number. Expected %u, got %u\n",
-               ota_ctx.chunk_info.next_expected_chunk, chunk_number);
+        LOG_ERROR("[OTA_MANAGER] Unexpected chunk number. Expected %u, got %u",
+                  ota_ctx.chunk_info.next_expected_chunk, chunk_number);
         return OTA_ERROR_COMMUNICATION;
     }
     
     if (data == NULL || size == 0 || size > ota_ctx.chunk_info.chunk_size) {
-        printf("[OTA_MANAGER] Error: Invalid chunk data\n");
+        LOG_ERROR("[OTA_MANAGER] Invalid chunk data");
         return OTA_ERROR_INVALID_SIZE;
     }
     
     if (ota_ctx.chunk_info.received_bytes + size > ota_ctx.chunk_info.total_size) {
-        printf("[OTA_MANAGER] Error: Chunk exceeds total size\n");
+        LOG_ERROR("[OTA_MANAGER] Chunk exceeds total size");
         return OTA_ERROR_INVALID_SIZE;
     }
     
@@ -143,8 +145,8 @@ ota_error_t ota_manager_receive_chunk(uint32_t chunk_number, const uint8_t* data
     // Calculate write address
     uint32_t write_address = APP_SLOT_B_ADDRESS + ota_ctx.chunk_info.received_bytes;
     
-    printf("[OTA_MANAGER] Receiving chunk %u/%u (%u bytes) -> 0x%08X\n",
-           chunk_number + 1, ota_ctx.chunk_info.total_chunks, size, write_address);
+    LOG_DEBUG("[OTA_MANAGER] Receiving chunk %u/%u (%u bytes) -> 0x%08X",
+              chunk_number + 1, ota_ctx.chunk_info.total_chunks, size, write_address);
     
     // Write data to flash
     for (uint32_t i = 0; i < size; i += 4) {
@@ -158,8 +160,8 @@ ota_error_t ota_manager_receive_chunk(uint32_t chunk_number, const uint8_t* data
         
         bootloader_error_t error = flash_write_word(write_address + i, word);
         if (error != BOOT_OK) {
-            printf("[OTA_MANAGER] Error: Failed to write to flash at 0x%08X\n",
-                   write_address + i);
+            LOG_ERROR("[OTA_MANAGER] Failed to write to flash at 0x%08X",
+                      write_address + i);
             update_state(OTA_STATE_ERROR, OTA_ERROR_FLASH_ERROR);
             return OTA_ERROR_FLASH_ERROR;
         }
@@ -176,39 +178,38 @@ ota_error_t ota_manager_receive_chunk(uint32_t chunk_number, const uint8_t* data
                                  ota_ctx.chunk_info.total_size);
     update_progress(progress);
     
-    printf("[OTA_MANAGER] Chunk %u received successfully\n", chunk_number);
-    printf("  Received: %u/%u bytes (%.1f%%)\n",
-           ota_ctx.chunk_info.received_bytes, ota_ctx.chunk_info.total_size,
-           (float)ota_ctx.chunk_info.received_bytes * 100.0f / ota_ctx.chunk_info.total_size);
+    LOG_DEBUG("[OTA_MANAGER] Chunk %u received successfully (Received: %u/%u bytes, %.1f%%)",
+              chunk_number, ota_ctx.chunk_info.received_bytes, ota_ctx.chunk_info.total_size,
+              (float)ota_ctx.chunk_info.received_bytes * 100.0f / ota_ctx.chunk_info.total_size);
     
     return OTA_ERROR_NONE;
 }
 
 ota_error_t ota_manager_finalize_update(void) {
     if (ota_ctx.state != OTA_STATE_RECEIVING_DATA) {
-        printf("[OTA_MANAGER] Error: Not in receiving state\n");
+        LOG_ERROR("[OTA_MANAGER] Not in receiving state");
         return OTA_ERROR_INVALID_STATE;
     }
     
     if (ota_ctx.chunk_info.received_bytes != ota_ctx.chunk_info.total_size) {
-        printf("[OTA_MANAGER] Error: Incomplete transfer. Received %u/%u bytes\n",
-               ota_ctx.chunk_info.received_bytes, ota_ctx.chunk_info.total_size);
+        LOG_ERROR("[OTA_MANAGER] Incomplete transfer. Received %u/%u bytes",
+                  ota_ctx.chunk_info.received_bytes, ota_ctx.chunk_info.total_size);
         return OTA_ERROR_INVALID_SIZE;
     }
     
     update_state(OTA_STATE_VALIDATING, OTA_ERROR_NONE);
     update_progress(95);
     
-    printf("[OTA_MANAGER] All chunks received (%u bytes total)\n", 
-           ota_ctx.chunk_info.received_bytes);
-    printf("[OTA_MANAGER] Starting validation...\n");
+    LOG_INFO("[OTA_MANAGER] All chunks received (%u bytes total)", 
+             ota_ctx.chunk_info.received_bytes);
+    LOG_INFO("[OTA_MANAGER] Starting validation...");
     
     // Validate the received firmware
     return ota_manager_validate_update();
 }
 
 ota_error_t ota_manager_validate_update(void) {
-    printf("[OTA_MANAGER] Validating firmware...\n");
+    LOG_INFO("[OTA_MANAGER] Validating firmware...");
     
     // Read firmware header
     memcpy(&ota_ctx.firmware_header, &flash_memory[APP_SLOT_B_ADDRESS], 
@@ -216,7 +217,7 @@ ota_error_t ota_manager_validate_update(void) {
     
     // Validate header
     if (!validate_firmware_header(&ota_ctx.firmware_header)) {
-        printf("[OTA_MANAGER] Error: Invalid firmware header\n");
+        LOG_ERROR("[OTA_MANAGER] Invalid firmware header");
         update_state(OTA_STATE_ERROR, OTA_ERROR_VALIDATION_FAILED);
         failed_updates++;
         return OTA_ERROR_VALIDATION_FAILED;
@@ -224,8 +225,8 @@ ota_error_t ota_manager_validate_update(void) {
     
     // Check size matches
     if (ota_ctx.firmware_header.size != ota_ctx.chunk_info.total_size) {
-        printf("[OTA_MANAGER] Error: Size mismatch. Header: %u, Received: %u\n",
-               ota_ctx.firmware_header.size, ota_ctx.chunk_info.total_size);
+        LOG_ERROR("[OTA_MANAGER] Size mismatch. Header: %u, Received: %u",
+                  ota_ctx.firmware_header.size, ota_ctx.chunk_info.total_size);
         update_state(OTA_STATE_ERROR, OTA_ERROR_VALIDATION_FAILED);
         failed_updates++;
         return OTA_ERROR_VALIDATION_FAILED;
@@ -237,9 +238,8 @@ ota_error_t ota_manager_validate_update(void) {
         ota_ctx.firmware_header.size - sizeof(firmware_header_t));
     
     if (calculated_crc != ota_ctx.firmware_header.crc32) {
-        printf("[OTA_MANAGER] Error: CRC mismatch\n");
-        printf("  Calculated: 0x%08X\n", calculated_crc);
-        printf("  Expected:   0x%08X\n", ota_ctx.firmware_header.crc32);
+        LOG_ERROR("[OTA_MANAGER] CRC mismatch (Calculated: 0x%08X, Expected: 0x%08X)",
+                  calculated_crc, ota_ctx.firmware_header.crc32);
         update_state(OTA_STATE_ERROR, OTA_ERROR_CRC_MISMATCH);
         failed_updates++;
         return OTA_ERROR_CRC_MISMATCH;
@@ -247,16 +247,15 @@ ota_error_t ota_manager_validate_update(void) {
     
     // Call application validation callback if set
     if (validate_callback && !validate_callback(&ota_ctx.firmware_header)) {
-        printf("[OTA_MANAGER] Error: Application validation failed\n");
+        LOG_ERROR("[OTA_MANAGER] Application validation failed");
         update_state(OTA_STATE_ERROR, OTA_ERROR_VALIDATION_FAILED);
         failed_updates++;
         return OTA_ERROR_VALIDATION_FAILED;
     }
     
-    printf("[OTA_MANAGER] Firmware validation successful!\n");
-    printf("  Version: %s\n", ota_ctx.firmware_header.version_string);
-    printf("  Size: %u bytes\n", ota_ctx.firmware_header.size);
-    printf("  CRC32: 0x%08X ✓\n", ota_ctx.firmware_header.crc32);
+    LOG_INFO("[OTA_MANAGER] Firmware validation successful! (Version: %s, Size: %u bytes, "
+             "CRC32: 0x%08X)", ota_ctx.firmware_header.version_string,
+             ota_ctx.firmware_header.size, ota_ctx.firmware_header.crc32);
     
     update_state(OTA_STATE_COMPLETE, OTA_ERROR_NONE);
     update_progress(100);
@@ -268,37 +267,37 @@ ota_error_t ota_manager_validate_update(void) {
 }
 
 ota_error_t ota_manager_abort_update(void) {
-    printf("[OTA_MANAGER] Aborting update...\n");
+    LOG_INFO("[OTA_MANAGER] Aborting update...");
     
     ota_ctx.abort_requested = true;
     failed_updates++;
     
     update_state(OTA_STATE_ERROR, OTA_ERROR_COMMUNICATION);
     
-    printf("[OTA_MANAGER] Update aborted\n");
+    LOG_INFO("[OTA_MANAGER] Update aborted");
     
     return OTA_ERROR_NONE;
 }
 
 void ota_manager_apply_update(void) {
     if (ota_ctx.state != OTA_STATE_COMPLETE) {
-        printf("[OTA_MANAGER] Error: Cannot apply incomplete update\n");
+        LOG_ERROR("[OTA_MANAGER] Cannot apply incomplete update");
         return;
     }
     
-    printf("[OTA_MANAGER] Applying update...\n");
+    LOG_INFO("[OTA_MANAGER] Applying update...");
     update_state(OTA_STATE_UPDATING, OTA_ERROR_NONE);
     
     // Switch to the new firmware
     bootloader_error_t error = bootloader_switch_to_update();
     if (error != BOOT_OK) {
-        printf("[OTA_MANAGER] Error: Failed to switch to update: %d\n", error);
+        LOG_ERROR("[OTA_MANAGER] Failed to switch to update: %d", error);
         update_state(OTA_STATE_ERROR, OTA_ERROR_FLASH_ERROR);
         return;
     }
     
-    printf("[OTA_MANAGER] Update applied successfully!\n");
-    printf("[OTA_MANAGER] System restart required to run new firmware\n");
+    LOG_INFO("[OTA_MANAGER] Update applied successfully!");
+    LOG_INFO("[OTA_MANAGER] System restart required to run new firmware");
     
     ota_ctx.restart_required = true;
 }
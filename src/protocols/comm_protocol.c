@@ -1,4 +1,8 @@
+#define LOG_MODULE LOG_MODULE_PROTOCOL
+
 #include "comm_protocol.h"
+#include "../utils/trace.h"
+#include "../utils/logger.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -46,20 +50,18 @@ void protocol_init(protocol_handler_t* handler) {
     handler->sequence_counter = 1; // Start from 1
     handler->initialized = true;
     
-    printf("[PROTOCOL] Protocol handler initialized\n");
+    LOG_INFO("[PROTOCOL] Protocol handler initialized");
 }
 
 void protocol_deinit(protocol_handler_t* handler) {
     if (!handler) return;
     
     handler->initialized = false;
-    printf("[PROTOCOL] Protocol handler deinitialized\n");
+    LOG_INFO("[PROTOCOL] Protocol handler deinitialized");
 }
 
-uint16_t protocol_calculate_crc(const uint8_t* data, uint16_t length) {
-    uint16_t crc = 0xFFFF;
-    
-    for (uint16_t i = 0; i < length; i++) {
+uint16_t protocol_crc_update(uint16_t crc, const uint8_t* data, uint32_t length) {
+    for (uint32_t i = 0; i < length; i++) {
         uint8_t index = (uint8_t)((crc >> 8) ^ data[i]);
         crc = (crc << 8) ^ crc_table[index];
     }
@@ -67,16 +69,20 @@ uint16_t protocol_calculate_crc(const uint8_t* data, uint16_t length) {
     return crc;
 }
 
+uint16_t protocol_calculate_crc(const uint8_t* data, uint16_t length) {
+    return protocol_crc_update(PROTOCOL_CRC_INIT, data, length);
+}
+
 uint16_t protocol_create_packet(uint8_t command, const uint8_t* data, 
                                uint16_t data_len, uint8_t* buffer, 
                                uint16_t buffer_size, protocol_handler_t* handler) {
     if (!buffer || buffer_size < PROTOCOL_HEADER_SIZE + data_len + PROTOCOL_CRC_SIZE + 2) {
-        printf("[PROTOCOL] Error: Buffer too small\n");
+        LOG_ERROR("[PROTOCOL] Buffer too small");
         return 0;
     }
     
     if (data_len > PROTOCOL_MAX_PACKET_SIZE) {
-        printf("[PROTOCOL] Error: Data too large\n");
+        LOG_ERROR("[PROTOCOL] Data too large");
         return 0;
     }
     
@@ -118,8 +124,8 @@ uint16_t protocol_create_packet(uint8_t command, const uint8_t* data,
     // End byte
     buffer[packet_size++] = PROTOCOL_END_BYTE;
     
-    printf("[PROTOCOL] Created packet: CMD=0x%02X, SEQ=%u, Len=%u, CRC=0x%04X\n",
-           command, sequence, data_len, crc);
+    TRACE(TRACE_CAT_PROTOCOL, "Created packet: CMD=0x%02X, SEQ=%u, Len=%u, CRC=0x%04X",
+          command, sequence, data_len, crc);
     
     return packet_size;
 }
@@ -127,19 +133,19 @@ uint16_t protocol_create_packet(uint8_t command, const uint8_t* data,
 bool protocol_parse_packet(const uint8_t* buffer, uint16_t buffer_len,
                           protocol_packet_t* packet, protocol_handler_t* handler) {
     if (!buffer || !packet || buffer_len < PROTOCOL_HEADER_SIZE + PROTOCOL_CRC_SIZE + 2) {
-        printf("[PROTOCOL] Error: Invalid parameters\n");
+        LOG_ERROR("[PROTOCOL] Invalid parameters");
         return false;
     }
     
     // Check start byte
     if (buffer[0] != PROTOCOL_START_BYTE) {
-        printf("[PROTOCOL] Error: Invalid start byte: 0x%02X\n", buffer[0]);
+        TRACE(TRACE_CAT_PROTOCOL, "Invalid start byte: 0x%02X", buffer[0]);
         return false;
     }
     
     // Check end byte
     if (buffer[buffer_len - 1] != PROTOCOL_END_BYTE) {
-        printf("[PROTOCOL] Error: Invalid end byte: 0x%02X\n", buffer[buffer_len - 1]);
+        TRACE(TRACE_CAT_PROTOCOL, "Invalid end byte: 0x%02X", buffer[buffer_len - 1]);
         return false;
     }
     
@@ -152,8 +158,8 @@ bool protocol_parse_packet(const uint8_t* buffer, uint16_t buffer_len,
     // Validate length
     uint16_t expected_packet_size = PROTOCOL_HEADER_SIZE + packet->length + PROTOCOL_CRC_SIZE + 1;
     if (buffer_len != expected_packet_size) {
-        printf("[PROTOCOL] Error: Length mismatch. Expected %u, got %u\n",
-               expected_packet_size, buffer_len);
+        TRACE(TRACE_CAT_PROTOCOL, "Length mismatch. Expected %u, got %u",
+              expected_packet_size, buffer_len);
         if (handler) handler->crc_errors++;
         return false;
     }
@@ -171,8 +177,8 @@ bool protocol_parse_packet(const uint8_t* buffer, uint16_t buffer_len,
     packet->end_byte = buffer[buffer_len - 1];
     
     if (received_crc != calculated_crc) {
-        printf("[PROTOCOL] Error: CRC mismatch. Received: 0x%04X, Calculated: 0x%04X\n",
-               received_crc, calculated_crc);
+        TRACE(TRACE_CAT_PROTOCOL, "CRC mismatch. Received: 0x%04X, Calculated: 0x%04X",
+              received_crc, calculated_crc);
         if (handler) handler->crc_errors++;
         return false;
     }
@@ -183,8 +189,8 @@ bool protocol_parse_packet(const uint8_t* buffer, uint16_t buffer_len,
         handler->bytes_received += buffer_len;
     }
     
-    printf("[PROTOCOL] Parsed packet: CMD=0x%02X, SEQ=%u, Len=%u, CRC=0x%04X ✓\n",
-           packet->command, packet->sequence, packet->length, packet->crc);
+    TRACE(TRACE_CAT_PROTOCOL, "Parsed packet: CMD=0x%02X, SEQ=%u, Len=%u, CRC=0x%04X",
+          packet->command, packet->sequence, packet->length, packet->crc);
     
     return true;
 }
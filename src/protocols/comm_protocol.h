@@ -11,6 +11,7 @@
 #define PROTOCOL_MAX_PACKET_SIZE 256
 #define PROTOCOL_HEADER_SIZE    6
 #define PROTOCOL_CRC_SIZE       2
+#define PROTOCOL_CRC_INIT       0xFFFF
 
 // Command definitions
 typedef enum {
@@ -80,6 +81,10 @@ bool protocol_parse_packet(const uint8_t* buffer, uint16_t buffer_len,
 // CRC calculation
 uint16_t protocol_calculate_crc(const uint8_t* data, uint16_t length);
 
+// Incremental CRC: start from PROTOCOL_CRC_INIT and feed each segment in
+// order (e.g. both iovecs of a circular buffer) to avoid staging a copy
+uint16_t protocol_crc_update(uint16_t crc, const uint8_t* data, uint32_t length);
+
 // Helper functions
 const char* protocol_command_to_string(uint8_t command);
 const char* protocol_error_to_string(uint8_t error);
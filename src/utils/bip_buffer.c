@@ -0,0 +1,145 @@
+#include "bip_buffer.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Indices are handed between producer and consumer with acquire/release
+#define BB_LOAD(index)          atomic_load_explicit(&(index), memory_order_acquire)
+#define BB_STORE(index, value)  atomic_store_explicit(&(index), (value), memory_order_release)
+
+bool bip_buffer_init(bip_buffer_t* bb, size_t capacity) {
+    if (!bb || capacity == 0) {
+        return false;
+    }
+    
+    bb->buffer = (uint8_t*)malloc(capacity);
+    if (!bb->buffer) {
+        return false;
+    }
+    
+    bb->capacity = capacity;
+    atomic_init(&bb->read, 0);
+    atomic_init(&bb->write, 0);
+    atomic_init(&bb->watermark, capacity);
+    bb->reserve_start = 0;
+    bb->reserve_size = 0;
+    
+    return true;
+}
+
+void bip_buffer_destroy(bip_buffer_t* bb) {
+    if (bb && bb->buffer) {
+        free(bb->buffer);
+        bb->buffer = NULL;
+        bb->capacity = 0;
+        bb->reserve_size = 0;
+    }
+}
+
+uint8_t* bip_buffer_reserve(bip_buffer_t* bb, size_t size) {
+    if (!bb || !bb->buffer || size == 0) {
+        return NULL;
+    }
+    
+    size_t write = atomic_load_explicit(&bb->write, memory_order_relaxed);
+    size_t read = BB_LOAD(bb->read);
+    size_t start;
+    
+    if (write >= read) {
+        // Data (if any) is [read, write): free space is the tail, then the head
+        if (bb->capacity - write >= size) {
+            start = write;
+        } else if (read > size) {
+            // Keep one byte free so write never catches up with read
+            start = 0;
+        } else {
+            return NULL;
+        }
+    } else {
+        // Already wrapped: free space is [write, read)
+        if (read - write > size) {
+            start = write;
+        } else {
+            return NULL;
+        }
+    }
+    
+    bb->reserve_start = start;
+    bb->reserve_size = size;
+    
+    return &bb->buffer[start];
+}
+
+void bip_buffer_commit(bip_buffer_t* bb, size_t size) {
+    if (!bb || bb->reserve_size == 0) {
+        return;
+    }
+    
+    if (size > bb->reserve_size) {
+        size = bb->reserve_size;
+    }
+    bb->reserve_size = 0;
+    
+    if (size == 0) {
+        return; // Cancelled, nothing to publish
+    }
+    
+    size_t write = atomic_load_explicit(&bb->write, memory_order_relaxed);
+    size_t start = bb->reserve_start;
+    
+    if (start < write) {
+        // Wrapped: tell the reader where the valid data before the wrap ends
+        BB_STORE(bb->watermark, write);
+    }
+    
+    BB_STORE(bb->write, start + size);
+}
+
+const uint8_t* bip_buffer_read(bip_buffer_t* bb, size_t* size) {
+    if (!bb || !bb->buffer) {
+        if (size) *size = 0;
+        return NULL;
+    }
+    
+    size_t write = BB_LOAD(bb->write);
+    size_t watermark = BB_LOAD(bb->watermark);
+    size_t read = atomic_load_explicit(&bb->read, memory_order_relaxed);
+    
+    // Writer has wrapped and everything before the watermark is consumed
+    if (write < read && read == watermark) {
+        read = 0;
+        BB_STORE(bb->read, 0);
+    }
+    
+    size_t available = (write < read) ? watermark - read : write - read;
+    if (size) *size = available;
+    
+    return available > 0 ? &bb->buffer[read] : NULL;
+}
+
+void bip_buffer_release(bip_buffer_t* bb, size_t size) {
+    if (!bb || size == 0) {
+        return;
+    }
+    
+    size_t available = 0;
+    if (!bip_buffer_read(bb, &available)) {
+        return;
+    }
+    
+    if (size > available) {
+        size = available;
+    }
+    
+    size_t read = atomic_load_explicit(&bb->read, memory_order_relaxed);
+    BB_STORE(bb->read, read + size);
+}
+
+bool bip_buffer_is_empty(const bip_buffer_t* bb) {
+    if (!bb) return true;
+    
+    size_t write = BB_LOAD(bb->write);
+    size_t read = BB_LOAD(bb->read);
+    
+    // After a wrap write < read, and [0, write) still holds data
+    return write == read;
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef BIP_BUFFER_H
+#define BIP_BUFFER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+// Bipartite buffer: a ring that only ever hands out contiguous regions.
+//
+// A reservation that does not fit before the physical end wraps to the
+// start instead, and the skipped tail is marked by 'watermark' so the
+// reader jumps over it. Records can therefore be built in place and read
+// back in place, at the cost of some wasted space at the end.
+//
+// One producer and one consumer may use it from different threads without
+// a lock: the producer only stores 'write' and 'watermark', the consumer
+// only stores 'read'.
+// Producer calls: reserve, commit. Consumer calls: read, release.
+typedef struct {
+    uint8_t* buffer;
+    size_t capacity;
+    atomic_size_t read;         // Next byte to read
+    atomic_size_t write;        // End of committed data
+    atomic_size_t watermark;    // End of valid data before a wrap
+    size_t reserve_start;       // Producer-private: pending reservation
+    size_t reserve_size;
+} bip_buffer_t;
+
+// Initialize a bip-buffer
+bool bip_buffer_init(bip_buffer_t* bb, size_t capacity);
+
+// Destroy a bip-buffer
+void bip_buffer_destroy(bip_buffer_t* bb);
+
+// Reserve 'size' contiguous bytes for writing, or NULL if they don't fit
+uint8_t* bip_buffer_reserve(bip_buffer_t* bb, size_t size);
+
+// Publish the first 'size' bytes of the reservation (0 cancels it)
+void bip_buffer_commit(bip_buffer_t* bb, size_t size);
+
+// Get the next contiguous block of committed data, or NULL if empty
+const uint8_t* bip_buffer_read(bip_buffer_t* bb, size_t* size);
+
+// Release 'size' bytes from the front of the block returned by read
+void bip_buffer_release(bip_buffer_t* bb, size_t size);
+
+// Check if there is no committed data
+bool bip_buffer_is_empty(const bip_buffer_t* bb);
+
+#endif
\ No newline at end of file
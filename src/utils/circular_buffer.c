@@ -1,8 +1,188 @@
+#ifdef __linux__
+#define _GNU_SOURCE  // memfd_create
+#endif
+
 #include "circular_buffer.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// ==================== INDEX ACCESS ====================
+// head and tail are atomics so SPSC mode can hand them between threads:
+// stores release the bytes they cover and loads acquire them. On x86 these
+// are plain moves. Macros rather than inline functions because -Os will
+// not inline the atomic accessors.
+#define CB_HEAD(cb)             atomic_load_explicit(&(cb)->head, memory_order_acquire)
+#define CB_TAIL(cb)             atomic_load_explicit(&(cb)->tail, memory_order_acquire)
+#define CB_SET_HEAD(cb, value)  atomic_store_explicit(&(cb)->head, (value), memory_order_release)
+#define CB_SET_TAIL(cb, value)  atomic_store_explicit(&(cb)->tail, (value), memory_order_release)
+
+// ==================== MASKED (POWER-OF-TWO) MODE ====================
+// Free-running indices: 'tail - head' is the fill level even after the
+// size_t counters wrap, and 'index & mask' replaces '% capacity'.
+static inline size_t cb_masked_used(const circular_buffer_t* cb) {
+    return CB_TAIL(cb) - CB_HEAD(cb);
+}
+
+static size_t cb_masked_write(circular_buffer_t* cb, const uint8_t* data, size_t size) {
+    // In SPSC mode the producer owns tail and only observes head
+    size_t head = CB_HEAD(cb);
+    size_t tail = CB_TAIL(cb);
+    size_t used = tail - head;
+    size_t requested = size;
+    
+    if (!cb->overwrite) {
+        size_t free_space = cb->capacity - used;
+        if (size > free_space) size = free_space;
+        if (size == 0) return 0;
+        requested = size;
+    } else {
+        // Only the newest 'capacity' bytes can survive
+        if (size > cb->capacity) {
+            data += size - cb->capacity;
+            size = cb->capacity;
+        }
+        if (used + size > cb->capacity) {
+            CB_SET_HEAD(cb, head + used + size - cb->capacity);
+        }
+    }
+    
+    size_t offset = tail & cb->mask;
+    size_t first = cb->mirrored ? size : cb->capacity - offset;
+    if (first > size) first = size;
+    
+    memcpy(&cb->buffer[offset], data, first);
+    if (first < size) {
+        memcpy(cb->buffer, data + first, size - first);
+    }
+    
+    // Publish the bytes only after they are in place
+    CB_SET_TAIL(cb, tail + size);
+    
+    return requested;
+}
+
+static size_t cb_masked_peek(const circular_buffer_t* cb, uint8_t* data, size_t size, size_t offset) {
+    // In SPSC mode the consumer owns head and only observes tail
+    size_t head = CB_HEAD(cb);
+    size_t used = CB_TAIL(cb) - head;
+    if (offset >= used) return 0;
+    
+    if (size > used - offset) size = used - offset;
+    
+    size_t start = (head + offset) & cb->mask;
+    size_t first = cb->mirrored ? size : cb->capacity - start;
+    if (first > size) first = size;
+    
+    memcpy(data, &cb->buffer[start], first);
+    if (first < size) {
+        memcpy(data + first, cb->buffer, size - first);
+    }
+    
+    return size;
+}
+
+bool circular_buffer_init_pow2(circular_buffer_t* cb, size_t capacity, bool overwrite) {
+    if (!cb || capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return false;
+    }
+    
+    if (!circular_buffer_init(cb, capacity, overwrite)) {
+        return false;
+    }
+    
+    cb->mask = capacity - 1;
+    cb->masked = true;
+    
+    return true;
+}
+
+bool circular_buffer_init_spsc(circular_buffer_t* cb, size_t capacity) {
+    // The producer may never move head, so overwrite is not available
+    return circular_buffer_init_pow2(cb, capacity, false);
+}
+
+// ==================== MIRRORED (DOUBLE-MAPPED) MODE ====================
+// The same memfd pages are mapped twice, back to back, so buffer[i] and
+// buffer[i + capacity] are the same byte. Any span of up to 'capacity'
+// bytes starting inside the first mapping is contiguous in memory.
+#ifdef __linux__
+static uint8_t* cb_mirror_map(size_t capacity) {
+    int fd = memfd_create("circular_buffer", MFD_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+    
+    if (ftruncate(fd, (off_t)capacity) != 0) {
+        close(fd);
+        return NULL;
+    }
+    
+    // Reserve both halves first so nothing else can land in between
+    uint8_t* base = (uint8_t*)mmap(NULL, 2 * capacity, PROT_NONE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return NULL;
+    }
+    
+    void* lower = mmap(base, capacity, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_FIXED, fd, 0);
+    void* upper = mmap(base + capacity, capacity, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_FIXED, fd, 0);
+    close(fd);
+    
+    if (lower == MAP_FAILED || upper == MAP_FAILED) {
+        munmap(base, 2 * capacity);
+        return NULL;
+    }
+    
+    return base;
+}
+#endif
+
+bool circular_buffer_init_mirrored(circular_buffer_t* cb, size_t capacity, bool overwrite) {
+    if (!cb || capacity == 0) {
+        return false;
+    }
+
+#ifdef __linux__
+    // Round up to a power of two that is at least one page
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t rounded = page;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    
+    uint8_t* storage = cb_mirror_map(rounded);
+    if (!storage) {
+        printf("[CBUF] Error: Failed to double-map %zu bytes\n", rounded);
+        return false;
+    }
+    
+    cb->buffer = storage;
+    cb->capacity = rounded;
+    atomic_init(&cb->head, 0);
+    atomic_init(&cb->tail, 0);
+    cb->count = 0;
+    cb->mask = rounded - 1;
+    cb->masked = true;
+    cb->mirrored = true;
+    cb->overwrite = overwrite;
+    
+    return true;
+#else
+    (void)overwrite;
+    return false;
+#endif
+}
+
+// ==================== COMMON API ====================
 bool circular_buffer_init(circular_buffer_t* cb, size_t capacity, bool overwrite) {
     if (!cb || capacity == 0) {
         return false;
@@ -14,9 +194,12 @@ bool circular_buffer_init(circular_buffer_t* cb, size_t capacity, bool overwrite
     }
     
     cb->capacity = capacity;
-    cb->head = 0;
-    cb->tail = 0;
+    atomic_init(&cb->head, 0);
+    atomic_init(&cb->tail, 0);
     cb->count = 0;
+    cb->mask = 0;
+    cb->masked = false;
+    cb->mirrored = false;
     cb->overwrite = overwrite;
     
     return true;
@@ -24,37 +207,49 @@ bool circular_buffer_init(circular_buffer_t* cb, size_t capacity, bool overwrite
 
 void circular_buffer_destroy(circular_buffer_t* cb) {
     if (cb && cb->buffer) {
+#ifdef __linux__
+        if (cb->mirrored) {
+            munmap(cb->buffer, 2 * cb->capacity);
+        } else {
+            free(cb->buffer);
+        }
+#else
         free(cb->buffer);
+#endif
         cb->buffer = NULL;
         cb->capacity = 0;
-        cb->head = 0;
-        cb->tail = 0;
+        CB_SET_HEAD(cb, 0);
+        CB_SET_TAIL(cb, 0);
         cb->count = 0;
+        cb->mask = 0;
+        cb->masked = false;
+        cb->mirrored = false;
     }
 }
 
 void circular_buffer_clear(circular_buffer_t* cb) {
     if (cb) {
-        cb->head = 0;
-        cb->tail = 0;
+        CB_SET_HEAD(cb, 0);
+        CB_SET_TAIL(cb, 0);
         cb->count = 0;
     }
 }
 
 bool circular_buffer_is_empty(const circular_buffer_t* cb) {
-    return cb ? (cb->count == 0) : true;
+    return circular_buffer_size(cb) == 0;
 }
 
 bool circular_buffer_is_full(const circular_buffer_t* cb) {
-    return cb ? (cb->count == cb->capacity) : true;
+    return cb ? (circular_buffer_size(cb) == cb->capacity) : true;
 }
 
 size_t circular_buffer_size(const circular_buffer_t* cb) {
-    return cb ? cb->count : 0;
+    if (!cb) return 0;
+    return cb->masked ? cb_masked_used(cb) : cb->count;
 }
 
 size_t circular_buffer_free(const circular_buffer_t* cb) {
-    return cb ? (cb->capacity - cb->count) : 0;
+    return cb ? (cb->capacity - circular_buffer_size(cb)) : 0;
 }
 
 size_t circular_buffer_write(circular_buffer_t* cb, const uint8_t* data, size_t size) {
@@ -62,6 +257,10 @@ size_t circular_buffer_write(circular_buffer_t* cb, const uint8_t* data, size_t
         return 0;
     }
     
+    if (cb->masked) {
+        return cb_masked_write(cb, data, size);
+    }
+    
     // If buffer is full and overwrite is disabled, return 0
     if (circular_buffer_is_full(cb) && !cb->overwrite) {
         return 0;
@@ -71,7 +270,7 @@ size_t circular_buffer_write(circular_buffer_t* cb, const uint8_t* data, size_t
     
     while (written < size) {
         // Calculate available space from tail to end of buffer
-        size_t available_to_end = cb->capacity - cb->tail;
+        size_t available_to_end = cb->capacity - CB_TAIL(cb);
         size_t contiguous_write = (size - written < available_to_end) ? 
                                   (size - written) : available_to_end;
         
@@ -83,16 +282,16 @@ size_t circular_buffer_write(circular_buffer_t* cb, const uint8_t* data, size_t
             
             // Need to advance head to make space
             size_t overflow = cb->count + contiguous_write - cb->capacity;
-            cb->head = (cb->head + overflow) % cb->capacity;
+            CB_SET_HEAD(cb, (CB_HEAD(cb) + overflow) % cb->capacity);
             cb->count -= overflow;
         }
         
         // Copy data
-        memcpy(&cb->buffer[cb->tail], &data[written], contiguous_write);
+        memcpy(&cb->buffer[CB_TAIL(cb)], &data[written], contiguous_write);
         written += contiguous_write;
         
         // Update tail and count
-        cb->tail = (cb->tail + contiguous_write) % cb->capacity;
+        CB_SET_TAIL(cb, (CB_TAIL(cb) + contiguous_write) % cb->capacity);
         cb->count += contiguous_write;
     }
     
@@ -100,7 +299,17 @@ size_t circular_buffer_write(circular_buffer_t* cb, const uint8_t* data, size_t
 }
 
 size_t circular_buffer_read(circular_buffer_t* cb, uint8_t* data, size_t size) {
-    if (!cb || !data || size == 0 || circular_buffer_is_empty(cb)) {
+    if (!cb || !data || size == 0) {
+        return 0;
+    }
+    
+    if (cb->masked) {
+        size_t read = cb_masked_peek(cb, data, size, 0);
+        CB_SET_HEAD(cb, CB_HEAD(cb) + read);
+        return read;
+    }
+    
+    if (cb->count == 0) {
         return 0;
     }
     
@@ -109,16 +318,16 @@ size_t circular_buffer_read(circular_buffer_t* cb, uint8_t* data, size_t size) {
     
     while (read < to_read) {
         // Calculate available data from head to end of buffer
-        size_t available_to_end = cb->capacity - cb->head;
+        size_t available_to_end = cb->capacity - CB_HEAD(cb);
         size_t contiguous_read = (to_read - read < available_to_end) ? 
                                  (to_read - read) : available_to_end;
         
         // Copy data
-        memcpy(&data[read], &cb->buffer[cb->head], contiguous_read);
+        memcpy(&data[read], &cb->buffer[CB_HEAD(cb)], contiguous_read);
         read += contiguous_read;
         
         // Update head and count
-        cb->head = (cb->head + contiguous_read) % cb->capacity;
+        CB_SET_HEAD(cb, (CB_HEAD(cb) + contiguous_read) % cb->capacity);
         cb->count -= contiguous_read;
     }
     
@@ -126,13 +335,21 @@ size_t circular_buffer_read(circular_buffer_t* cb, uint8_t* data, size_t size) {
 }
 
 size_t circular_buffer_peek(const circular_buffer_t* cb, uint8_t* data, size_t size, size_t offset) {
-    if (!cb || !data || size == 0 || offset >= cb->count) {
+    if (!cb || !data || size == 0) {
+        return 0;
+    }
+    
+    if (cb->masked) {
+        return cb_masked_peek(cb, data, size, offset);
+    }
+    
+    if (offset >= cb->count) {
         return 0;
     }
     
     size_t to_peek = (size < cb->count - offset) ? size : (cb->count - offset);
     size_t peeked = 0;
-    size_t virtual_head = (cb->head + offset) % cb->capacity;
+    size_t virtual_head = (CB_HEAD(cb) + offset) % cb->capacity;
     
     while (peeked < to_peek) {
         size_t available_to_end = cb->capacity - virtual_head;
@@ -153,13 +370,17 @@ const uint8_t* circular_buffer_get_read_ptr(const circular_buffer_t* cb, size_t*
         return NULL;
     }
     
-    size_t contiguous_available = cb->capacity - cb->head;
-    if (contiguous_available > cb->count) {
-        contiguous_available = cb->count;
+    size_t used = circular_buffer_size(cb);
+    size_t head = CB_HEAD(cb);
+    if (cb->masked) head &= cb->mask;
+    // The mirror makes everything up to 'used' readable in one span
+    size_t contiguous_available = cb->mirrored ? used : cb->capacity - head;
+    if (contiguous_available > used) {
+        contiguous_available = used;
     }
     
     if (available) *available = contiguous_available;
-    return &cb->buffer[cb->head];
+    return &cb->buffer[head];
 }
 
 void circular_buffer_advance_read(circular_buffer_t* cb, size_t size) {
@@ -167,8 +388,15 @@ void circular_buffer_advance_read(circular_buffer_t* cb, size_t size) {
         return;
     }
     
-    size_t to_advance = (size < cb->count) ? size : cb->count;
-    cb->head = (cb->head + to_advance) % cb->capacity;
+    size_t used = circular_buffer_size(cb);
+    size_t to_advance = (size < used) ? size : used;
+    
+    if (cb->masked) {
+        CB_SET_HEAD(cb, CB_HEAD(cb) + to_advance);
+        return;
+    }
+    
+    CB_SET_HEAD(cb, (CB_HEAD(cb) + to_advance) % cb->capacity);
     cb->count -= to_advance;
 }
 
@@ -178,14 +406,16 @@ uint8_t* circular_buffer_get_write_ptr(circular_buffer_t* cb, size_t* available)
         return NULL;
     }
     
-    size_t contiguous_available = cb->capacity - cb->tail;
-    size_t free_space = cb->capacity - cb->count;
+    size_t tail = CB_TAIL(cb);
+    if (cb->masked) tail &= cb->mask;
+    size_t free_space = circular_buffer_free(cb);
+    size_t contiguous_available = cb->mirrored ? free_space : cb->capacity - tail;
     if (contiguous_available > free_space) {
         contiguous_available = free_space;
     }
     
     if (available) *available = contiguous_available;
-    return &cb->buffer[cb->tail];
+    return &cb->buffer[tail];
 }
 
 void circular_buffer_advance_write(circular_buffer_t* cb, size_t size) {
@@ -193,35 +423,62 @@ void circular_buffer_advance_write(circular_buffer_t* cb, size_t size) {
         return;
     }
     
-    size_t free_space = cb->capacity - cb->count;
+    size_t free_space = circular_buffer_free(cb);
     size_t to_advance = (size < free_space) ? size : free_space;
     
-    cb->tail = (cb->tail + to_advance) % cb->capacity;
+    if (cb->masked) {
+        CB_SET_TAIL(cb, CB_TAIL(cb) + to_advance);
+        return;
+    }
+    
+    CB_SET_TAIL(cb, (CB_TAIL(cb) + to_advance) % cb->capacity);
     cb->count += to_advance;
 }
 
-ssize_t circular_buffer_find(const circular_buffer_t* cb, const uint8_t* pattern, size_t pattern_size) {
-    if (!cb || !pattern || pattern_size == 0 || pattern_size > cb->count) {
-        return -1;
+// Split 'length' bytes starting at physical index 'start' into iovecs
+static int cb_fill_iov(const circular_buffer_t* cb, size_t start, size_t length, struct iovec iov[2]) {
+    if (length == 0) return 0;
+    
+    size_t first = cb->mirrored ? length : cb->capacity - start;
+    if (first > length) first = length;
+    
+    iov[0].iov_base = &cb->buffer[start];
+    iov[0].iov_len = first;
+    if (first == length) return 1;
+    
+    iov[1].iov_base = cb->buffer;
+    iov[1].iov_len = length - first;
+    return 2;
+}
+
+size_t circular_buffer_get_read_iov(const circular_buffer_t* cb, struct iovec iov[2], int* iovcnt) {
+    if (!cb || !iov) {
+        if (iovcnt) *iovcnt = 0;
+        return 0;
     }
     
-    for (size_t i = 0; i <= cb->count - pattern_size; i++) {
-        bool found = true;
-        
-        for (size_t j = 0; j < pattern_size; j++) {
-            size_t index = (cb->head + i + j) % cb->capacity;
-            if (cb->buffer[index] != pattern[j]) {
-                found = false;
-                break;
-            }
-        }
-        
-        if (found) {
-            return (ssize_t)i;
-        }
+    size_t used = circular_buffer_size(cb);
+    size_t head = CB_HEAD(cb);
+    if (cb->masked) head &= cb->mask;
+    
+    int count = cb_fill_iov(cb, head, used, iov);
+    if (iovcnt) *iovcnt = count;
+    return used;
+}
+
+size_t circular_buffer_get_write_iov(circular_buffer_t* cb, struct iovec iov[2], int* iovcnt) {
+    if (!cb || !iov) {
+        if (iovcnt) *iovcnt = 0;
+        return 0;
     }
     
-    return -1;
+    size_t free_space = circular_buffer_free(cb);
+    size_t tail = CB_TAIL(cb);
+    if (cb->masked) tail &= cb->mask;
+    
+    int count = cb_fill_iov(cb, tail, free_space, iov);
+    if (iovcnt) *iovcnt = count;
+    return free_space;
 }
 
 size_t circular_buffer_copy(circular_buffer_t* dest, const circular_buffer_t* src, size_t size) {
@@ -229,31 +486,116 @@ size_t circular_buffer_copy(circular_buffer_t* dest, const circular_buffer_t* sr
         return 0;
     }
     
-    size_t to_copy = (size < src->count) ? size : src->count;
-    size_t free_space = dest->capacity - dest->count;
+    size_t src_used = circular_buffer_size(src);
+    size_t to_copy = (size < src_used) ? size : src_used;
+    size_t free_space = circular_buffer_free(dest);
     
     if (to_copy > free_space && !dest->overwrite) {
         to_copy = free_space;
     }
     
-    size_t copied = 0;
-    size_t src_pos = src->head;
+    // At most two source segments, each handed to write() in one call
+    struct iovec iov[2];
+    int iovcnt = 0;
+    circular_buffer_get_read_iov(src, iov, &iovcnt);
     
-    while (copied < to_copy) {
-        // Calculate contiguous block in source
-        size_t src_available_to_end = src->capacity - src_pos;
-        size_t src_contiguous = (to_copy - copied < src_available_to_end) ? 
-                                (to_copy - copied) : src_available_to_end;
+    size_t copied = 0;
+    for (int i = 0; i < iovcnt && copied < to_copy; i++) {
+        size_t chunk = to_copy - copied;
+        if (chunk > iov[i].iov_len) chunk = iov[i].iov_len;
         
-        // Write to destination
-        size_t written = circular_buffer_write(dest, &src->buffer[src_pos], src_contiguous);
-        if (written == 0) {
+        size_t written = circular_buffer_write(dest, (const uint8_t*)iov[i].iov_base, chunk);
+        copied += written;
+        if (written < chunk) {
             break;
         }
-        
-        copied += written;
-        src_pos = (src_pos + written) % src->capacity;
     }
     
     return copied;
+}
+
+// ==================== PATTERN SEARCH ====================
+// Scan with memchr (vectorized by the C library) for the first byte and
+// confirm with memcmp. When that byte turns out to be common and the
+// pattern is long enough, switch to Horspool for the rest of the span.
+#define CB_HORSPOOL_MIN_PATTERN 8
+#define CB_MEMCHR_MIN_STRIDE    16  // Bytes skipped per candidate before switching
+
+static size_t cb_search_horspool(const uint8_t* hay, size_t n, size_t pos,
+                                 const uint8_t* pattern, size_t m) {
+    // Shift by the distance of the window's last byte from the pattern end
+    size_t shift[256];
+    for (size_t i = 0; i < 256; i++) shift[i] = m;
+    for (size_t i = 0; i < m - 1; i++) shift[pattern[i]] = m - 1 - i;
+    
+    uint8_t last = pattern[m - 1];
+    while (pos <= n - m) {
+        uint8_t c = hay[pos + m - 1];
+        if (c == last && memcmp(hay + pos, pattern, m - 1) == 0) {
+            return pos;
+        }
+        pos += shift[c];
+    }
+    return n;
+}
+
+// Find the first occurrence of pattern in a linear span, or return n
+static size_t cb_search_linear(const uint8_t* hay, size_t n, const uint8_t* pattern, size_t m) {
+    if (m > n) return n;
+    
+    const uint8_t* p = hay;
+    const uint8_t* end = hay + (n - m);
+    size_t candidates = 0;
+    
+    while (p <= end) {
+        p = (const uint8_t*)memchr(p, pattern[0], (size_t)(end - p) + 1);
+        if (!p) return n;
+        if (memcmp(p + 1, pattern + 1, m - 1) == 0) return (size_t)(p - hay);
+        p++;
+        
+        candidates++;
+        if (m >= CB_HORSPOOL_MIN_PATTERN &&
+            candidates * CB_MEMCHR_MIN_STRIDE > (size_t)(p - hay) + 64) {
+            return cb_search_horspool(hay, n, (size_t)(p - hay), pattern, m);
+        }
+    }
+    return n;
+}
+
+ssize_t circular_buffer_find(const circular_buffer_t* cb, const uint8_t* pattern, size_t pattern_size) {
+    size_t used = circular_buffer_size(cb);
+    if (!cb || !pattern || pattern_size == 0 || pattern_size > used) {
+        return -1;
+    }
+    
+    size_t start = CB_HEAD(cb);
+    if (cb->masked) start &= cb->mask;
+    
+    // Split the readable bytes into the span before the wrap and the rest
+    size_t first_len = cb->mirrored ? used : cb->capacity - start;
+    if (first_len > used) first_len = used;
+    size_t second_len = used - first_len;
+    const uint8_t* first = &cb->buffer[start];
+    
+    // 1. Matches entirely before the wrap
+    size_t pos = cb_search_linear(first, first_len, pattern, pattern_size);
+    if (pos < first_len) return (ssize_t)pos;
+    if (second_len == 0) return -1;
+    
+    // 2. Matches straddling the wrap: at most pattern_size - 1 candidates
+    size_t straddle = first_len >= pattern_size ? first_len - pattern_size + 1 : 0;
+    for (; straddle < first_len; straddle++) {
+        size_t head_part = first_len - straddle;
+        if (pattern_size - head_part > second_len) break;
+        if (memcmp(first + straddle, pattern, head_part) == 0 &&
+            memcmp(cb->buffer, pattern + head_part, pattern_size - head_part) == 0) {
+            return (ssize_t)straddle;
+        }
+    }
+    
+    // 3. Matches entirely after the wrap
+    pos = cb_search_linear(cb->buffer, second_len, pattern, pattern_size);
+    if (pos < second_len) return (ssize_t)(first_len + pos);
+    
+    return -1;
 }
\ No newline at end of file
@@ -4,20 +4,65 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <sys/types.h>
+#include <stdatomic.h>
+
+#ifdef _WIN32
+// Same layout as the POSIX struct iovec, which Windows lacks
+struct iovec {
+    void* iov_base;
+    size_t iov_len;
+};
+#else
+#include <sys/uio.h>
+#endif
 
 // Circular buffer structure
+//
+// Two indexing modes share this structure:
+//  - modulo mode (circular_buffer_init): any capacity, head/tail wrap with
+//    '% capacity' and 'count' tracks the fill level.
+//  - masked mode (circular_buffer_init_pow2): capacity is a power of two,
+//    head/tail are free-running and only masked when indexing the storage;
+//    the fill level is 'tail - head' and 'count' is unused.
+//  - SPSC mode (circular_buffer_init_spsc): masked mode shared by exactly one
+//    producer thread and one consumer thread without a lock. The producer
+//    only stores 'tail' and the consumer only stores 'head', both with
+//    release ordering; each side loads the other's index with acquire.
+//    Producer calls: write, get_write_ptr, advance_write, free, is_full.
+//    Consumer calls: read, peek, get_read_ptr, advance_read, find, size,
+//    is_empty. clear() and destroy() need both sides stopped.
+//  - mirrored mode (circular_buffer_init_mirrored, Linux only): masked mode
+//    whose storage is mapped twice back to back, so get_read_ptr() and
+//    get_write_ptr() always return the full readable/writable length as
+//    one span. Combines with SPSC use when overwrite is off.
 typedef struct {
     uint8_t* buffer;
     size_t capacity;
-    size_t head;
-    size_t tail;
+    atomic_size_t head;
+    atomic_size_t tail;
     size_t count;
+    size_t mask;
+    bool masked;
+    bool mirrored;
     bool overwrite;
 } circular_buffer_t;
 
 // Initialize a circular buffer
 bool circular_buffer_init(circular_buffer_t* cb, size_t capacity, bool overwrite);
 
+// Initialize a circular buffer in masked mode (capacity must be a power of two)
+bool circular_buffer_init_pow2(circular_buffer_t* cb, size_t capacity, bool overwrite);
+
+// Initialize a lock-free single-producer/single-consumer buffer
+// (capacity must be a power of two, overwrite is always disabled)
+bool circular_buffer_init_spsc(circular_buffer_t* cb, size_t capacity);
+
+// Initialize a double-mapped buffer whose pointers never wrap (capacity is
+// rounded up to a power-of-two number of pages). Returns false where the
+// platform has no memfd/mmap support; fall back to circular_buffer_init_pow2.
+bool circular_buffer_init_mirrored(circular_buffer_t* cb, size_t capacity, bool overwrite);
+
 // Destroy a circular buffer
 void circular_buffer_destroy(circular_buffer_t* cb);
 
@@ -57,6 +102,14 @@ uint8_t* circular_buffer_get_write_ptr(circular_buffer_t* cb, size_t* available)
 // Advance write pointer
 void circular_buffer_advance_write(circular_buffer_t* cb, size_t size);
 
+// Describe all readable bytes as up to two segments (before and after the
+// wrap). Returns the total length; *iovcnt receives 0, 1 or 2.
+size_t circular_buffer_get_read_iov(const circular_buffer_t* cb, struct iovec iov[2], int* iovcnt);
+
+// Describe all free space as up to two segments; fill them, then call
+// circular_buffer_advance_write() with the number of bytes produced
+size_t circular_buffer_get_write_iov(circular_buffer_t* cb, struct iovec iov[2], int* iovcnt);
+
 // Find a byte pattern in buffer
 ssize_t circular_buffer_find(const circular_buffer_t* cb, const uint8_t* pattern, size_t pattern_size);
 
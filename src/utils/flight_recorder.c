@@ -0,0 +1,711 @@
+#include "flight_recorder.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#define flight_open(path)           _open((path), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, \
+                                          _S_IREAD | _S_IWRITE)
+#define flight_write(fd, buf, len)  _write((fd), (buf), (unsigned)(len))
+#define flight_close(fd)            _close(fd)
+#else
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#define flight_open(path)           open((path), O_WRONLY | O_CREAT | O_TRUNC, 0644)
+#define flight_write(fd, buf, len)  write((fd), (buf), (len))
+#define flight_close(fd)            close(fd)
+#endif
+
+// Per-thread ring; only its owner thread writes, a dump may read any time.
+// A ring outlives its thread so the dump still shows what it did; only
+// once every ring is taken does a new thread take over an exited one.
+typedef struct {
+    atomic_bool claimed;
+    atomic_bool exited;                 // Owner thread has exited
+    atomic_uint head;                   // Events ever written
+    flight_event_t events[FLIGHT_RECORDER_EVENTS];
+} flight_ring_t;
+
+static flight_ring_t flight_rings[FLIGHT_RECORDER_MAX_THREADS];
+static _Thread_local flight_ring_t* flight_local_ring = NULL;
+static _Thread_local bool flight_no_ring = false;
+
+#ifdef _WIN32
+static DWORD flight_exit_key = FLS_OUT_OF_INDEXES;
+static INIT_ONCE flight_exit_once = INIT_ONCE_STATIC_INIT;
+#else
+static pthread_key_t flight_exit_key;
+static bool flight_exit_key_created = false;
+static pthread_once_t flight_exit_once = PTHREAD_ONCE_INIT;
+#endif
+
+static char flight_path[FLIGHT_RECORDER_PATH_MAX];
+static atomic_bool flight_dumped = false;
+static bool flight_installed = false;
+
+static const int flight_signals[] = { SIGSEGV, SIGABRT, SIGILL, SIGFPE
+#ifndef _WIN32
+    , SIGBUS
+#endif
+};
+#define FLIGHT_SIGNAL_COUNT (sizeof(flight_signals) / sizeof(flight_signals[0]))
+
+#ifndef _WIN32
+static struct sigaction flight_previous[FLIGHT_SIGNAL_COUNT];
+static char flight_alt_stack[64 * 1024];    // Handler still runs after a stack overflow
+#endif
+
+// ==================== RECORDING ====================
+// Runs on the exiting thread; anything it logs after this goes unrecorded
+#ifdef _WIN32
+static void WINAPI flight_thread_exit(PVOID arg) {
+#else
+static void flight_thread_exit(void* arg) {
+#endif
+    flight_ring_t* ring = (flight_ring_t*)arg;
+    flight_local_ring = NULL;
+    flight_no_ring = true;
+    if (ring) atomic_store_explicit(&ring->exited, true, memory_order_release);
+}
+
+#ifdef _WIN32
+static BOOL CALLBACK flight_exit_key_create(PINIT_ONCE once, PVOID param, PVOID* context) {
+    (void)once; (void)param; (void)context;
+    flight_exit_key = FlsAlloc(flight_thread_exit);
+    return TRUE;
+}
+#else
+static void flight_exit_key_create(void) {
+    flight_exit_key_created = pthread_key_create(&flight_exit_key, flight_thread_exit) == 0;
+}
+#endif
+
+static flight_ring_t* flight_take(flight_ring_t* ring) {
+#ifdef _WIN32
+    InitOnceExecuteOnce(&flight_exit_once, flight_exit_key_create, NULL, NULL);
+    if (flight_exit_key != FLS_OUT_OF_INDEXES) FlsSetValue(flight_exit_key, ring);
+#else
+    pthread_once(&flight_exit_once, flight_exit_key_create);
+    if (flight_exit_key_created) pthread_setspecific(flight_exit_key, ring);
+#endif
+    flight_local_ring = ring;
+    return ring;
+}
+
+static flight_ring_t* flight_ring(void) {
+    if (flight_local_ring) return flight_local_ring;
+    if (flight_no_ring) return NULL;
+    
+    for (int i = 0; i < FLIGHT_RECORDER_MAX_THREADS; i++) {
+        bool expected = false;
+        if (atomic_compare_exchange_strong(&flight_rings[i].claimed, &expected, true)) {
+            return flight_take(&flight_rings[i]);
+        }
+    }
+    
+    // All taken: continue the ring of a thread that has exited, whose
+    // oldest events are overwritten first
+    for (int i = 0; i < FLIGHT_RECORDER_MAX_THREADS; i++) {
+        bool expected = true;
+        if (atomic_compare_exchange_strong(&flight_rings[i].exited, &expected, false)) {
+            return flight_take(&flight_rings[i]);
+        }
+    }
+    
+    flight_no_ring = true; // More live threads than rings: this one is not recorded
+    return NULL;
+}
+
+// Next slot of this thread's ring; published by flight_commit(). The
+// slot is marked unwritten first, so a dump reading it meanwhile (the
+// oldest slot is the one being overwritten) drops it instead of pairing
+// the kind of one event with the source of another.
+static flight_event_t* flight_reserve(flight_ring_t* ring) {
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    flight_event_t* event = &ring->events[head & (FLIGHT_RECORDER_EVENTS - 1)];
+    
+    atomic_store_explicit(&event->sequence, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    return event;
+}
+
+static void flight_commit(flight_ring_t* ring) {
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    flight_event_t* event = &ring->events[head & (FLIGHT_RECORDER_EVENTS - 1)];
+    
+    atomic_store_explicit(&event->sequence, head + 1, memory_order_release);
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+// Copy event 'index' of a ring; false if it is being or has been rewritten
+static bool flight_read(const flight_ring_t* ring, uint32_t index, flight_event_t* event) {
+    const flight_event_t* slot = &ring->events[index & (FLIGHT_RECORDER_EVENTS - 1)];
+    
+    if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != index + 1) {
+        return false;
+    }
+    
+    memcpy(event, slot, sizeof(*event));
+    
+    // An owner that lapped the ring meanwhile changed the sequence first
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&slot->sequence, memory_order_relaxed) == index + 1;
+}
+
+void flight_recorder_log(log_site_t* site, va_list args) {
+    flight_ring_t* ring = flight_ring();
+    if (!ring || !logger_site_prepare(site)) return;
+    
+    flight_event_t* event = flight_reserve(ring);
+    event->timestamp_us = logger_timestamp_us();
+    event->source = site;
+    event->kind = FLIGHT_EVENT_LOG;
+    event->string[0] = '\0';
+    
+    uint8_t count = site->arg_count < FLIGHT_RECORDER_MAX_ARGS ?
+                    site->arg_count : FLIGHT_RECORDER_MAX_ARGS;
+    bool have_string = false;
+    
+    va_list copy;
+    va_copy(copy, args);
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t type = site->arg_types[i];
+        uint64_t raw = 0;
+        switch (type) {
+            case LOG_ARG_INT:     raw = (uint64_t)(int64_t)va_arg(copy, int); break;
+            case LOG_ARG_LONG:    raw = (uint64_t)(int64_t)va_arg(copy, long); break;
+            case LOG_ARG_LLONG:   raw = (uint64_t)va_arg(copy, long long); break;
+            case LOG_ARG_SIZE:    raw = (uint64_t)va_arg(copy, size_t); break;
+            case LOG_ARG_INTMAX:  raw = (uint64_t)va_arg(copy, intmax_t); break;
+            case LOG_ARG_PTRDIFF: raw = (uint64_t)va_arg(copy, ptrdiff_t); break;
+            case LOG_ARG_POINTER: raw = (uint64_t)(uintptr_t)va_arg(copy, void*); break;
+            case LOG_ARG_DOUBLE:
+            case LOG_ARG_LDOUBLE: {
+                double value = type == LOG_ARG_LDOUBLE ? (double)va_arg(copy, long double)
+                                                       : va_arg(copy, double);
+                memcpy(&raw, &value, sizeof(raw));
+                type = LOG_ARG_DOUBLE;
+                break;
+            }
+            case LOG_ARG_STRING: {
+                const char* str = va_arg(copy, const char*);
+                // Only the first string is kept; others render as '?'
+                raw = have_string ? 0 : 1;
+                if (!have_string) {
+                    size_t len = str ? strnlen(str, FLIGHT_RECORDER_STRING_MAX - 1) : 0;
+                    memcpy(event->string, str ? str : "", len);
+                    event->string[len] = '\0';
+                    have_string = true;
+                }
+                break;
+            }
+        }
+        event->arg_types[i] = type;
+        event->args[i] = raw;
+    }
+    va_end(copy);
+    
+    event->arg_count = count;
+    flight_commit(ring);
+}
+
+void flight_recorder_trace(const trace_record_t* record) {
+    flight_ring_t* ring = flight_ring();
+    if (!ring) return;
+    
+    flight_event_t* event = flight_reserve(ring);
+    event->timestamp_us = record->timestamp_us;
+    event->source = record->point;
+    event->kind = FLIGHT_EVENT_TRACE;
+    event->arg_count = TRACE_MAX_ARGS;
+    event->string[0] = '\0';
+    for (int i = 0; i < TRACE_MAX_ARGS; i++) {
+        event->arg_types[i] = LOG_ARG_INT;
+        event->args[i] = record->args[i];
+    }
+    flight_commit(ring);
+}
+
+uint32_t flight_recorder_count(void) {
+    uint32_t count = 0;
+    for (int i = 0; i < FLIGHT_RECORDER_MAX_THREADS; i++) {
+        count += atomic_load_explicit(&flight_rings[i].head, memory_order_relaxed);
+    }
+    return count;
+}
+
+// ==================== RENDERING ====================
+// Everything below runs inside signal handlers: no stdio, no malloc,
+// no locks; text is built in a caller buffer and written with write().
+typedef struct {
+    char* pos;
+    char* end;
+} flight_text_t;
+
+static void text_char(flight_text_t* text, char c) {
+    if (text->pos < text->end) *text->pos++ = c;
+}
+
+static void text_string(flight_text_t* text, const char* str) {
+    while (*str) text_char(text, *str++);
+}
+
+static void text_padded(flight_text_t* text, const char* digits, size_t len,
+                        int width, bool left, bool zero) {
+    int pad = width > (int)len ? width - (int)len : 0;
+    
+    // Zero padding goes after the sign
+    if (zero && !left && len > 0 && (digits[0] == '-' || digits[0] == '+')) {
+        text_char(text, *digits++);
+        len--;
+    }
+    if (!left) {
+        while (pad-- > 0) text_char(text, zero ? '0' : ' ');
+    }
+    for (size_t i = 0; i < len; i++) text_char(text, digits[i]);
+    if (left) {
+        while (pad-- > 0) text_char(text, ' ');
+    }
+}
+
+// Digits of 'value' in 'base' at the end of 'buffer'; returns the first
+static char* format_unsigned(char* end, uint64_t value, unsigned base, bool upper, int min_digits) {
+    const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char* p = end;
+    do {
+        *--p = digits[value % base];
+        value /= base;
+        min_digits--;
+    } while (value != 0 || min_digits > 0);
+    return p;
+}
+
+static char* format_double(char* end, double value, int precision) {
+    char* p = end;
+    bool negative = value < 0.0;
+    if (negative) value = -value;
+    
+    if (value != value) {
+        p -= 3;
+        memcpy(p, "nan", 3);
+        return p;
+    }
+    if (value > 1e18) {
+        p -= 3;
+        memcpy(p, "big", 3);
+    } else {
+        if (precision > 9) precision = 9;
+        uint64_t scale = 1;
+        for (int i = 0; i < precision; i++) scale *= 10;
+        
+        uint64_t whole = (uint64_t)value;
+        uint64_t fraction = (uint64_t)((value - (double)whole) * (double)scale + 0.5);
+        if (fraction >= scale) {
+            whole++;
+            fraction -= scale;
+        }
+        
+        if (precision > 0) {
+            p = format_unsigned(p, fraction, 10, false, precision);
+            *--p = '.';
+        }
+        p = format_unsigned(p, whole, 10, false, 1);
+    }
+    
+    if (negative) *--p = '-';
+    return p;
+}
+
+// printf subset over recorded arguments: flags, width, precision, and
+// d i u x X o c p s f e g conversions (e and g are written like f)
+static void flight_render(flight_text_t* text, const char* format, const flight_event_t* event) {
+    uint8_t arg = 0;
+    
+    while (*format) {
+        if (*format != '%') {
+            text_char(text, *format++);
+            continue;
+        }
+        format++;
+        if (*format == '%') {
+            text_char(text, *format++);
+            continue;
+        }
+        
+        bool left = false, zero = false, plus = false, alt = false;
+        for (;; format++) {
+            if (*format == '-') left = true;
+            else if (*format == '0') zero = true;
+            else if (*format == '+') plus = true;
+            else if (*format == '#') alt = true;
+            else if (*format != ' ' && *format != '\'') break;
+        }
+        
+        int width = 0;
+        int precision = -1;
+        if (*format == '*') {
+            width = arg < event->arg_count ? (int)(int32_t)event->args[arg] : 0;
+            arg++;
+            format++;
+        }
+        while (*format >= '0' && *format <= '9') width = width * 10 + (*format++ - '0');
+        if (*format == '.') {
+            format++;
+            precision = 0;
+            if (*format == '*') {
+                precision = arg < event->arg_count ? (int)(int32_t)event->args[arg] : 0;
+                arg++;
+                format++;
+            }
+            while (*format >= '0' && *format <= '9') precision = precision * 10 + (*format++ - '0');
+            if (precision > 24) precision = 24;
+        }
+        while (*format && strchr("hlzjtL", *format)) format++;
+        
+        char conversion = *format;
+        if (conversion == '\0') break;
+        format++;
+        
+        if (arg >= event->arg_count) {
+            text_char(text, '?');
+            continue;
+        }
+        uint8_t type = event->arg_types[arg];
+        uint64_t value = event->args[arg++];
+        
+        // 'int' and 'long' arguments are 32 bits wide where it matters
+        bool narrow = type == LOG_ARG_INT || (type == LOG_ARG_LONG && sizeof(long) == 4);
+        
+        char buffer[48];
+        char* end = buffer + sizeof(buffer);
+        char* start = end;
+        
+        switch (conversion) {
+            case 'd':
+            case 'i': {
+                int64_t number = narrow ? (int32_t)value : (int64_t)value;
+                uint64_t magnitude = number < 0 ? 0 - (uint64_t)number : (uint64_t)number;
+                start = format_unsigned(end, magnitude, 10, false, precision > 0 ? precision : 1);
+                if (number < 0) *--start = '-';
+                else if (plus) *--start = '+';
+                break;
+            }
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o': {
+                unsigned base = conversion == 'u' ? 10 : conversion == 'o' ? 8 : 16;
+                if (narrow) value = (uint32_t)value;
+                start = format_unsigned(end, value, base, conversion == 'X',
+                                        precision > 0 ? precision : 1);
+                if (alt && base == 16 && value != 0) {
+                    *--start = conversion;
+                    *--start = '0';
+                }
+                break;
+            }
+            case 'p':
+                start = format_unsigned(end, value, 16, false, 1);
+                *--start = 'x';
+                *--start = '0';
+                break;
+            case 'c':
+                *--start = (char)value;
+                break;
+            case 's': {
+                const char* str = (type == LOG_ARG_STRING && value == 1) ? event->string : "?";
+                size_t len = strlen(str);
+                if (precision >= 0 && (size_t)precision < len) len = (size_t)precision;
+                text_padded(text, str, len, width, left, false);
+                continue;
+            }
+            case 'f': case 'F': case 'e': case 'E':
+            case 'g': case 'G': case 'a': case 'A': {
+                double number;
+                memcpy(&number, &value, sizeof(number));
+                start = format_double(end, number, precision >= 0 ? precision : 6);
+                if (plus && number >= 0.0) *--start = '+';
+                break;
+            }
+            default:
+                text_char(text, '?');
+                continue;
+        }
+        
+        text_padded(text, start, (size_t)(end - start), width, left, zero && precision < 0);
+    }
+}
+
+static void flight_render_event(flight_text_t* text, const flight_event_t* event, int thread) {
+    char number[24];
+    char* end = number + sizeof(number);
+    
+    // [seconds.micros] T<thread>
+    text_char(text, '[');
+    char* digits = format_unsigned(end, event->timestamp_us / 1000000u, 10, false, 1);
+    text_padded(text, digits, (size_t)(end - digits), 6, false, false);
+    text_char(text, '.');
+    digits = format_unsigned(end, event->timestamp_us % 1000000u, 10, false, 6);
+    text_padded(text, digits, (size_t)(end - digits), 0, false, false);
+    text_string(text, "] T");
+    digits = format_unsigned(end, (uint64_t)thread, 10, false, 1);
+    text_padded(text, digits, (size_t)(end - digits), 0, false, false);
+    text_char(text, ' ');
+    
+    if (event->kind == FLIGHT_EVENT_LOG) {
+        const log_site_t* site = (const log_site_t*)event->source;
+        const char* file = strrchr(site->file, '/');
+        file = file ? file + 1 : site->file;
+        
+        text_string(text, logger_level_to_string(site->level));
+        text_string(text, " (");
+        text_string(text, file);
+        text_char(text, ':');
+        digits = format_unsigned(end, (uint64_t)site->line, 10, false, 1);
+        text_padded(text, digits, (size_t)(end - digits), 0, false, false);
+        text_string(text, ") ");
+        flight_render(text, site->format, event);
+    } else {
+        const trace_point_t* point = (const trace_point_t*)event->source;
+        text_string(text, "TRACE ");
+        text_string(text, trace_category_to_string(point->category));
+        text_char(text, ' ');
+        flight_render(text, point->format, event);
+    }
+    
+    text_char(text, '\n');
+}
+
+// ==================== DUMP ====================
+size_t flight_recorder_dump_fd(int fd, const char* reason) {
+    uint32_t next[FLIGHT_RECORDER_MAX_THREADS];
+    uint32_t stop[FLIGHT_RECORDER_MAX_THREADS];
+    char line[512];
+    size_t written = 0;
+    
+    flight_text_t text = { line, line + sizeof(line) };
+    text_string(&text, "=== FLIGHT RECORDER: ");
+    text_string(&text, reason ? reason : "dump");
+    text_string(&text, " ===\n");
+    if (flight_write(fd, line, (size_t)(text.pos - line)) < 0) return 0;
+    
+    // The slot after the newest may be half-written by its owner right now.
+    // Each ring's next event is copied out before it is rendered; events
+    // their owner overwrites during the dump are skipped.
+    flight_event_t current[FLIGHT_RECORDER_MAX_THREADS];
+    bool loaded[FLIGHT_RECORDER_MAX_THREADS];
+    for (int i = 0; i < FLIGHT_RECORDER_MAX_THREADS; i++) {
+        stop[i] = atomic_load_explicit(&flight_rings[i].head, memory_order_acquire);
+        next[i] = stop[i] > FLIGHT_RECORDER_EVENTS - 1 ? stop[i] - (FLIGHT_RECORDER_EVENTS - 1) : 0;
+        loaded[i] = false;
+    }
+    
+    // Merge the threads by timestamp
+    while (1) {
+        int oldest = -1;
+        uint64_t oldest_us = 0;
+        for (int i = 0; i < FLIGHT_RECORDER_MAX_THREADS; i++) {
+            while (!loaded[i] && next[i] != stop[i]) {
+                loaded[i] = flight_read(&flight_rings[i], next[i], &current[i]);
+                if (!loaded[i]) next[i]++;
+            }
+            if (!loaded[i]) continue;
+            if (oldest < 0 || current[i].timestamp_us < oldest_us) {
+                oldest = i;
+                oldest_us = current[i].timestamp_us;
+            }
+        }
+        if (oldest < 0) break;
+        
+        loaded[oldest] = false;
+        next[oldest]++;
+        
+        text.pos = line;
+        flight_render_event(&text, &current[oldest], oldest);
+        if (text.pos == text.end) text.pos[-1] = '\n';
+        if (flight_write(fd, line, (size_t)(text.pos - line)) < 0) break;
+        written++;
+    }
+    
+    return written;
+}
+
+bool flight_recorder_dump(const char* path, const char* reason) {
+    int fd = flight_open(path);
+    if (fd < 0) return false;
+    
+    flight_recorder_dump_fd(fd, reason);
+    flight_close(fd);
+    return true;
+}
+
+// ==================== CRASH HANDLERS ====================
+static const char* flight_signal_name(int sig) {
+    switch (sig) {
+        case SIGSEGV: return "SIGSEGV";
+        case SIGABRT: return "SIGABRT";
+        case SIGILL:  return "SIGILL";
+        case SIGFPE:  return "SIGFPE";
+#ifndef _WIN32
+        case SIGBUS:  return "SIGBUS";
+#endif
+        default: return "signal";
+    }
+}
+
+static void flight_signal_handler(int sig) {
+    // First fatal event wins; a crash while dumping does not start over
+    if (!atomic_exchange(&flight_dumped, true)) {
+        flight_recorder_dump(flight_path, flight_signal_name(sig));
+    }
+    
+    // Let the default action (core dump, exit status) happen
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+bool flight_recorder_install(const char* path) {
+    if (!path || strlen(path) >= sizeof(flight_path)) {
+        printf("[FLIGHT] Error: Invalid dump path\n");
+        return false;
+    }
+    
+    flight_recorder_uninstall();
+    strcpy(flight_path, path);
+    atomic_store(&flight_dumped, false);
+
+#ifdef _WIN32
+    for (size_t i = 0; i < FLIGHT_SIGNAL_COUNT; i++) {
+        signal(flight_signals[i], flight_signal_handler);
+    }
+#else
+    stack_t stack = { .ss_sp = flight_alt_stack, .ss_size = sizeof(flight_alt_stack) };
+    sigaltstack(&stack, NULL);
+    
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = flight_signal_handler;
+    action.sa_flags = SA_ONSTACK | SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+    for (size_t i = 0; i < FLIGHT_SIGNAL_COUNT; i++) {
+        sigaction(flight_signals[i], &action, &flight_previous[i]);
+    }
+#endif
+
+    flight_installed = true;
+    printf("[FLIGHT] Recorder armed (%u events per thread, dump to %s)\n",
+           FLIGHT_RECORDER_EVENTS, path);
+    return true;
+}
+
+void flight_recorder_uninstall(void) {
+    if (!flight_installed) return;
+
+#ifdef _WIN32
+    for (size_t i = 0; i < FLIGHT_SIGNAL_COUNT; i++) {
+        signal(flight_signals[i], SIG_DFL);
+    }
+#else
+    for (size_t i = 0; i < FLIGHT_SIGNAL_COUNT; i++) {
+        sigaction(flight_signals[i], &flight_previous[i], NULL);
+    }
+#endif
+
+    flight_installed = false;
+}
+
+// ==================== WATCHDOG ====================
+static atomic_bool watchdog_running = false;
+static atomic_ullong watchdog_kicked_us = 0;
+static uint32_t watchdog_timeout_ms = 0;
+static void (*watchdog_on_expiry)(void) = NULL;
+
+#ifdef _WIN32
+static HANDLE watchdog_thread;
+#else
+static pthread_t watchdog_thread;
+#endif
+
+#ifdef _WIN32
+static DWORD WINAPI flight_watchdog(LPVOID arg) {
+#else
+static void* flight_watchdog(void* arg) {
+#endif
+    (void)arg;
+    
+    while (atomic_load_explicit(&watchdog_running, memory_order_acquire)) {
+        uint64_t now = logger_timestamp_us();
+        uint64_t kicked = atomic_load_explicit(&watchdog_kicked_us, memory_order_relaxed);
+        
+        if (now - kicked >= (uint64_t)watchdog_timeout_ms * 1000u) {
+            atomic_store(&watchdog_running, false);
+            if (!atomic_exchange(&flight_dumped, true) && flight_path[0]) {
+                flight_recorder_dump(flight_path, "watchdog");
+            }
+            printf("[FLIGHT] Watchdog expired (%u ms without a kick)\n", watchdog_timeout_ms);
+            
+            if (watchdog_on_expiry) {
+                watchdog_on_expiry();
+            } else {
+                abort();
+            }
+            break;
+        }
+
+#ifdef _WIN32
+        Sleep(10);
+#else
+        usleep(10000);
+#endif
+    }
+    
+    return 0;
+}
+
+bool flight_recorder_watchdog_start(uint32_t timeout_ms, void (*on_expiry)(void)) {
+    if (atomic_load(&watchdog_running) || timeout_ms == 0) return false;
+    
+    watchdog_timeout_ms = timeout_ms;
+    watchdog_on_expiry = on_expiry;
+    atomic_store(&watchdog_kicked_us, logger_timestamp_us());
+    atomic_store(&watchdog_running, true);
+
+#ifdef _WIN32
+    watchdog_thread = CreateThread(NULL, 0, flight_watchdog, NULL, 0, NULL);
+    if (watchdog_thread == NULL) {
+#else
+    if (pthread_create(&watchdog_thread, NULL, flight_watchdog, NULL) != 0) {
+#endif
+        atomic_store(&watchdog_running, false);
+        printf("[FLIGHT] Error: Failed to start watchdog\n");
+        return false;
+    }
+    
+    printf("[FLIGHT] Watchdog started (%u ms)\n", timeout_ms);
+    return true;
+}
+
+void flight_recorder_watchdog_kick(void) {
+    atomic_store_explicit(&watchdog_kicked_us, logger_timestamp_us(), memory_order_relaxed);
+}
+
+void flight_recorder_watchdog_stop(void) {
+    // Also reaps a monitor thread that has already expired
+    atomic_store(&watchdog_running, false);
+    if (watchdog_timeout_ms == 0) return;
+
+#ifdef _WIN32
+    WaitForSingleObject(watchdog_thread, INFINITE);
+    CloseHandle(watchdog_thread);
+#else
+    pthread_join(watchdog_thread, NULL);
+#endif
+
+    watchdog_timeout_ms = 0;
+}
\ No newline at end of file
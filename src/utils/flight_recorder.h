@@ -0,0 +1,65 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include "logger.h"
+#include "trace.h"
+
+// Flight recorder: every LOG_* call that passes its level filter and every
+// recorded TRACE() point also lands in a small per-thread ring of raw
+// events. Nothing is formatted or locked on the way in. The rings are
+// rendered only when they are dumped: on SIGSEGV / SIGABRT (and the other
+// fatal signals), on watchdog expiry, or on request.
+#define FLIGHT_RECORDER_EVENTS      256     // Per thread, power of two
+#define FLIGHT_RECORDER_MAX_THREADS 16      // Live threads; exited ones are reused
+#define FLIGHT_RECORDER_MAX_ARGS    6
+#define FLIGHT_RECORDER_STRING_MAX  16      // Bytes kept of the first %s argument
+#define FLIGHT_RECORDER_PATH_MAX    128
+
+typedef enum {
+    FLIGHT_EVENT_LOG = 0,               // source is a log_site_t
+    FLIGHT_EVENT_TRACE                  // source is a trace_point_t
+} flight_event_kind_t;
+
+typedef struct {
+    atomic_uint sequence;               // Ring position + 1 once written, 0 while writing
+    uint64_t timestamp_us;
+    const void* source;
+    uint8_t kind;                       // flight_event_kind_t
+    uint8_t arg_count;
+    uint8_t arg_types[FLIGHT_RECORDER_MAX_ARGS];    // log_arg_type_t
+    uint64_t args[FLIGHT_RECORDER_MAX_ARGS];        // Doubles as their bits
+    char string[FLIGHT_RECORDER_STRING_MAX];
+} flight_event_t;
+
+// Install the crash handlers; 'path' is where they write the dump
+bool flight_recorder_install(const char* path);
+
+// Restore the previous signal handlers
+void flight_recorder_uninstall(void);
+
+// Write the recorded events of every thread, oldest first, to an open
+// file descriptor. Async-signal-safe. Returns the number of events.
+size_t flight_recorder_dump_fd(int fd, const char* reason);
+
+// Same, to a file (truncated). Async-signal-safe.
+bool flight_recorder_dump(const char* path, const char* reason);
+
+// Events recorded by all threads since start-up
+uint32_t flight_recorder_count(void);
+
+// Watchdog: a monitor thread dumps the recorder if it is not kicked
+// within timeout_ms, then calls on_expiry (NULL: abort(), like a reset)
+bool flight_recorder_watchdog_start(uint32_t timeout_ms, void (*on_expiry)(void));
+void flight_recorder_watchdog_kick(void);
+void flight_recorder_watchdog_stop(void);
+
+// Internal: called by the logger and trace paths
+void flight_recorder_log(log_site_t* site, va_list args);
+void flight_recorder_trace(const trace_record_t* record);
+
+#endif
\ No newline at end of file
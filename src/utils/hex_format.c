@@ -0,0 +1,114 @@
+#include "hex_format.h"
+#include <string.h>
+
+// Digit pairs for every byte value: byte b is at [2 * b]
+static const char hex_lower[] =
+    "000102030405060708090a0b0c0d0e0f"
+    "101112131415161718191a1b1c1d1e1f"
+    "202122232425262728292a2b2c2d2e2f"
+    "303132333435363738393a3b3c3d3e3f"
+    "404142434445464748494a4b4c4d4e4f"
+    "505152535455565758595a5b5c5d5e5f"
+    "606162636465666768696a6b6c6d6e6f"
+    "707172737475767778797a7b7c7d7e7f"
+    "808182838485868788898a8b8c8d8e8f"
+    "909192939495969798999a9b9c9d9e9f"
+    "a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+    "b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+    "d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+    "e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+    "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+static const char hex_upper[] =
+    "000102030405060708090A0B0C0D0E0F"
+    "101112131415161718191A1B1C1D1E1F"
+    "202122232425262728292A2B2C2D2E2F"
+    "303132333435363738393A3B3C3D3E3F"
+    "404142434445464748494A4B4C4D4E4F"
+    "505152535455565758595A5B5C5D5E5F"
+    "606162636465666768696A6B6C6D6E6F"
+    "707172737475767778797A7B7C7D7E7F"
+    "808182838485868788898A8B8C8D8E8F"
+    "909192939495969798999A9B9C9D9E9F"
+    "A0A1A2A3A4A5A6A7A8A9AAABACADAEAF"
+    "B0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+    "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECF"
+    "D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+    "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEF"
+    "F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+// ==================== ENCODING ====================
+size_t hex_encode(char* dest, const uint8_t* data, size_t size, bool upper, char separator) {
+    const char* pairs = upper ? hex_upper : hex_lower;
+    char* out = dest;
+    
+    if (separator == '\0') {
+        for (size_t i = 0; i < size; i++) {
+            memcpy(out, &pairs[2 * data[i]], 2);
+            out += 2;
+        }
+    } else {
+        for (size_t i = 0; i < size; i++) {
+            memcpy(out, &pairs[2 * data[i]], 2);
+            out[2] = separator;
+            out += 3;
+        }
+    }
+    
+    return (size_t)(out - dest);
+}
+
+size_t hex_ascii(char* dest, const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        uint8_t c = data[i];
+        dest[i] = (uint8_t)(c - 32) < 95 ? (char)c : '.';
+    }
+    return size;
+}
+
+// ==================== DUMP ====================
+// Same digits as "%04zx"
+static size_t hex_offset(char* dest, size_t offset) {
+    size_t digits = 4;
+    while (digits < 2 * sizeof(size_t) && (offset >> (4 * digits)) != 0) {
+        digits++;
+    }
+    
+    for (size_t i = 0; i < digits; i++) {
+        dest[i] = hex_lower[2 * ((offset >> (4 * (digits - 1 - i))) & 0x0F) + 1];
+    }
+    return digits;
+}
+
+size_t hex_dump_rows(char* dest, const uint8_t* data, size_t size, size_t offset) {
+    char* out = dest;
+    
+    for (size_t i = 0; i < size; i += HEX_DUMP_BYTES_PER_ROW) {
+        size_t count = size - i < HEX_DUMP_BYTES_PER_ROW ? size - i : HEX_DUMP_BYTES_PER_ROW;
+        
+        // Offset
+        out[0] = ' ';
+        out[1] = ' ';
+        out += 2;
+        out += hex_offset(out, offset + i);
+        out[0] = ':';
+        out[1] = ' ';
+        out += 2;
+        
+        // Hex in two groups of eight, short rows padded to full width
+        size_t first = count < 8 ? count : 8;
+        out += hex_encode(out, data + i, first, false, ' ');
+        memset(out, ' ', 3 * (8 - first) + 1);
+        out += 3 * (8 - first) + 1;
+        out += hex_encode(out, data + i + first, count - first, false, ' ');
+        memset(out, ' ', 3 * (8 - (count - first)) + 1);
+        out += 3 * (8 - (count - first)) + 1;
+        
+        // ASCII
+        out += hex_ascii(out, data + i, count);
+        *out++ = '\n';
+    }
+    
+    return (size_t)(out - dest);
+}
\ No newline at end of file
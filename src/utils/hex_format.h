@@ -0,0 +1,33 @@
+#ifndef HEX_FORMAT_H
+#define HEX_FORMAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Block hex formatting for traces and dumps. Everything renders into a
+// caller buffer through lookup tables, so a whole block costs one write
+// to the output instead of one stdio call per byte.
+
+// Bytes per row of hex_dump_rows(), and the longest row it writes:
+// "  " + offset (4 to 16 digits) + ": " + 16 x "xx " + 2 gaps + 16
+// characters + newline
+#define HEX_DUMP_BYTES_PER_ROW  16
+#define HEX_DUMP_ROW_MAX        88
+
+// Space hex_dump_rows() needs for 'size' bytes
+#define HEX_DUMP_SIZE(size) \
+    ((((size) + HEX_DUMP_BYTES_PER_ROW - 1) / HEX_DUMP_BYTES_PER_ROW) * HEX_DUMP_ROW_MAX)
+
+// Two hex digits per byte, each pair followed by 'separator' unless it
+// is '\0'. Writes 2 or 3 characters per byte; returns the count. No NUL.
+size_t hex_encode(char* dest, const uint8_t* data, size_t size, bool upper, char separator);
+
+// Printable ASCII as-is, everything else as '.'. Returns 'size'. No NUL.
+size_t hex_ascii(char* dest, const uint8_t* data, size_t size);
+
+// Canonical dump rows ("  0010: 48 65 ... 6f  Hello..."), offsets starting
+// at 'offset'. 'dest' needs HEX_DUMP_SIZE(size) bytes; returns the length.
+size_t hex_dump_rows(char* dest, const uint8_t* data, size_t size, size_t offset);
+
+#endif
\ No newline at end of file
@@ -1,6 +1,22 @@
 #include "logger.h"
+#include "logger_binary.h"
+#include "hex_format.h"
+#include "flight_recorder.h"
+#include <stdlib.h>
 #include <string.h>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+// Longest formatted line (prefix + message); longer messages are truncated
+#define LOGGER_LINE_MAX 512
+
+// Bytes of a hex dump rendered per write; the rows stay inside the write buffer
+#define LOGGER_HEX_DUMP_BLOCK 512
+
 // Default configuration
 static logger_config_t logger_config = {
     .enable_timestamp = true,
@@ -11,7 +27,37 @@ static logger_config_t logger_config = {
     .output_stream = NULL
 };
 
+// Module level overrides; LOG_MODULE_INHERIT means "use the global level"
+#define LOG_MODULE_INHERIT 0xFF
+
+static uint8_t logger_module_override[LOG_MODULE_COUNT] = {
+    LOG_MODULE_INHERIT, LOG_MODULE_INHERIT, LOG_MODULE_INHERIT,
+    LOG_MODULE_INHERIT, LOG_MODULE_INHERIT
+};
+
+uint8_t logger_module_threshold[LOG_MODULE_COUNT] = {
+    LOG_LEVEL_INFO, LOG_LEVEL_INFO, LOG_LEVEL_INFO, LOG_LEVEL_INFO, LOG_LEVEL_INFO
+};
+
+static void logger_refresh_thresholds(void) {
+    for (int i = 0; i < LOG_MODULE_COUNT; i++) {
+        logger_module_threshold[i] = logger_module_override[i] != LOG_MODULE_INHERIT ?
+                                     logger_module_override[i] :
+                                     (uint8_t)logger_config.min_level;
+    }
+}
+
 void logger_init(logger_config_t* config) {
+    static bool exit_flush_registered = false;
+    
+    // Lines buffered for the old stream still go there
+    logger_flush();
+    
+    if (!exit_flush_registered) {
+        atexit(logger_flush);
+        exit_flush_registered = true;
+    }
+    
     if (config) {
         memcpy(&logger_config, config, sizeof(logger_config_t));
     }
@@ -20,15 +66,154 @@ void logger_init(logger_config_t* config) {
         logger_config.output_stream = stdout;
     }
     
+    logger_refresh_thresholds();
+    
+    // Pin the timestamp base now rather than at the first record
+    (void)logger_timestamp_us();
+    
     printf("[LOGGER] Initialized (min level: %s)\n", 
            logger_level_to_string(logger_config.min_level));
 }
 
 void logger_set_level(log_level_t level) {
     logger_config.min_level = level;
+    logger_refresh_thresholds();
     printf("[LOGGER] Log level set to: %s\n", logger_level_to_string(level));
 }
 
+void logger_set_module_level(log_module_t module, log_level_t level) {
+    if (module >= LOG_MODULE_COUNT) return;
+    
+    logger_module_override[module] = (uint8_t)level;
+    logger_refresh_thresholds();
+    printf("[LOGGER] %s log level set to: %s\n",
+           logger_module_to_string(module), logger_level_to_string(level));
+}
+
+void logger_clear_module_level(log_module_t module) {
+    if (module >= LOG_MODULE_COUNT) return;
+    
+    logger_module_override[module] = LOG_MODULE_INHERIT;
+    logger_refresh_thresholds();
+}
+
+log_level_t logger_get_module_level(log_module_t module) {
+    if (module >= LOG_MODULE_COUNT) return logger_config.min_level;
+    return (log_level_t)logger_module_threshold[module];
+}
+
+log_level_t logger_min_level(void) {
+    return logger_config.min_level;
+}
+
+FILE* logger_output(void) {
+    return logger_config.output_stream ? logger_config.output_stream : stdout;
+}
+
+// ==================== TIMESTAMPS ====================
+// Records carry microseconds from a monotonic clock; wall-clock time is
+// only derived when a line is printed, from the base captured here.
+static uint64_t logger_base_us = 0;
+static uint64_t logger_wall_base_us = 0;   // Unix time in microseconds
+
+// Wall-clock "HH:MM:SS" text, rebuilt only when the second changes
+typedef struct {
+    int64_t second;
+    char text[9];
+} logger_clock_cache_t;
+
+static _Thread_local logger_clock_cache_t logger_clock_cache = { -1, "" };
+
+static uint64_t logger_monotonic_us(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency = { 0 };
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    // Split to keep counter * 1000000 from overflowing on long uptimes
+    uint64_t seconds = (uint64_t)(counter.QuadPart / frequency.QuadPart);
+    uint64_t remainder = (uint64_t)(counter.QuadPart % frequency.QuadPart);
+    return seconds * 1000000u + remainder * 1000000u / (uint64_t)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+#endif
+}
+
+static uint64_t logger_wall_clock_us(void) {
+#ifdef _WIN32
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+    uint64_t ticks = ((uint64_t)ft.dwHighDateTime << 32) | ft.dwLowDateTime;
+    return ticks / 10u - 11644473600000000ULL; // 100 ns since 1601 -> Unix us
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+#endif
+}
+
+uint64_t logger_timestamp_us(void) {
+    if (logger_base_us == 0) {
+        logger_base_us = logger_monotonic_us();
+        logger_wall_base_us = logger_wall_clock_us();
+    }
+    
+    return logger_monotonic_us() - logger_base_us;
+}
+
+uint64_t logger_wall_clock_base_us(void) {
+    (void)logger_timestamp_us();
+    return logger_wall_base_us;
+}
+
+// Write "[HH:MM:SS.uuuuuu] " (18 characters) for a record timestamp
+static int logger_format_timestamp(char* dest, uint64_t timestamp_us) {
+    uint64_t wall_us = logger_wall_base_us + timestamp_us;
+    int64_t second = (int64_t)(wall_us / 1000000u);
+    uint32_t micros = (uint32_t)(wall_us % 1000000u);
+    logger_clock_cache_t* cache = &logger_clock_cache;
+    
+    if (second != cache->second) {
+        // Reentrant conversion: the async consumer and synchronous callers
+        // both get here, and localtime() shares one static buffer
+        time_t now = (time_t)second;
+        struct tm timeinfo;
+#ifdef _WIN32
+        bool converted = localtime_s(&timeinfo, &now) == 0;
+#else
+        bool converted = localtime_r(&now, &timeinfo) != NULL;
+#endif
+        if (converted) {
+            unsigned fields[3] = { (unsigned)timeinfo.tm_hour % 100u,
+                                   (unsigned)timeinfo.tm_min % 100u,
+                                   (unsigned)timeinfo.tm_sec % 100u };
+            for (int i = 0; i < 3; i++) {
+                cache->text[i * 3] = (char)('0' + fields[i] / 10u);
+                cache->text[i * 3 + 1] = (char)('0' + fields[i] % 10u);
+                if (i < 2) cache->text[i * 3 + 2] = ':';
+            }
+        } else {
+            memcpy(cache->text, "00:00:00", 8);
+        }
+        cache->second = second;
+    }
+    
+    dest[0] = '[';
+    memcpy(dest + 1, cache->text, 8);
+    dest[9] = '.';
+    for (int i = 15; i >= 10; i--) {
+        dest[i] = (char)('0' + micros % 10u);
+        micros /= 10u;
+    }
+    dest[16] = ']';
+    dest[17] = ' ';
+    return 18;
+}
+
 const char* logger_level_to_string(log_level_t level) {
     switch (level) {
         case LOG_LEVEL_DEBUG: return "DEBUG";
@@ -40,6 +225,17 @@ const char* logger_level_to_string(log_level_t level) {
     }
 }
 
+const char* logger_module_to_string(log_module_t module) {
+    switch (module) {
+        case LOG_MODULE_KERNEL:   return "KERNEL";
+        case LOG_MODULE_HAL:      return "HAL";
+        case LOG_MODULE_PROTOCOL: return "PROTOCOL";
+        case LOG_MODULE_OTA:      return "OTA";
+        case LOG_MODULE_APP:      return "APP";
+        default: return "UNKNOWN";
+    }
+}
+
 const char* logger_level_to_color(log_level_t level) {
     if (!logger_config.enable_color) {
         return "";
@@ -55,48 +251,521 @@ const char* logger_level_to_color(log_level_t level) {
     }
 }
 
-void logger_log(log_level_t level, const char* file, int line, const char* format, ...) {
-    // Check if we should log this message
-    if (level < logger_config.min_level) {
-        return;
+// ==================== CALL SITES ====================
+bool logger_site_prepare(log_site_t* site) {
+    unsigned char state = atomic_load_explicit(&site->parse_state, memory_order_acquire);
+    if (state == 2) return true;
+    
+    unsigned char expected = 0;
+    if (atomic_compare_exchange_strong(&site->parse_state, &expected, 1)) {
+        site->arg_count = logger_format_parse(site->format, site->arg_types);
+        
+        size_t size = 0;
+        site->has_strings = false;
+        for (uint8_t i = 0; i < site->arg_count; i++) {
+            size += logger_format_arg_size(site->arg_types[i]);
+            if (site->arg_types[i] == LOG_ARG_STRING) site->has_strings = true;
+        }
+        site->fixed_size = (uint16_t)size;
+        
+        atomic_store_explicit(&site->parse_state, 2, memory_order_release);
+        return true;
     }
     
-    // Get current time
-    time_t now = time(NULL);
-    struct tm* timeinfo = localtime(&now);
+    // Another thread is parsing this site right now; caller formats as text
+    return atomic_load_explicit(&site->parse_state, memory_order_acquire) == 2;
+}
+
+size_t logger_site_args_size(const log_site_t* site, va_list args) {
+    size_t size = site->fixed_size;
+    if (!site->has_strings) return size;
+    
+    // Strings are the only variable-size arguments
+    va_list scan;
+    va_copy(scan, args);
+    for (uint8_t i = 0; i < site->arg_count; i++) {
+        switch (site->arg_types[i]) {
+            case LOG_ARG_STRING: {
+                const char* str = va_arg(scan, const char*);
+                size_t len = str ? strnlen(str, LOGGER_MAX_STRING) : 6;
+                size += sizeof(uint16_t) + len;
+                break;
+            }
+            case LOG_ARG_INT:     (void)va_arg(scan, int); break;
+            case LOG_ARG_LONG:    (void)va_arg(scan, long); break;
+            case LOG_ARG_LLONG:   (void)va_arg(scan, long long); break;
+            case LOG_ARG_SIZE:    (void)va_arg(scan, size_t); break;
+            case LOG_ARG_INTMAX:  (void)va_arg(scan, intmax_t); break;
+            case LOG_ARG_PTRDIFF: (void)va_arg(scan, ptrdiff_t); break;
+            case LOG_ARG_DOUBLE:  (void)va_arg(scan, double); break;
+            case LOG_ARG_LDOUBLE: (void)va_arg(scan, long double); break;
+            case LOG_ARG_POINTER: (void)va_arg(scan, void*); break;
+        }
+    }
+    va_end(scan);
+    
+    return size;
+}
+
+size_t logger_site_pack_args(const log_site_t* site, va_list args, uint8_t* out) {
+    uint8_t* start = out;
+    
+    for (uint8_t i = 0; i < site->arg_count; i++) {
+        uint64_t raw = 0;
+        switch (site->arg_types[i]) {
+            case LOG_ARG_INT:     raw = (uint64_t)(int64_t)va_arg(args, int); break;
+            case LOG_ARG_LONG:    raw = (uint64_t)(int64_t)va_arg(args, long); break;
+            case LOG_ARG_LLONG:   raw = (uint64_t)va_arg(args, long long); break;
+            case LOG_ARG_SIZE:    raw = (uint64_t)va_arg(args, size_t); break;
+            case LOG_ARG_INTMAX:  raw = (uint64_t)va_arg(args, intmax_t); break;
+            case LOG_ARG_PTRDIFF: raw = (uint64_t)va_arg(args, ptrdiff_t); break;
+            case LOG_ARG_POINTER: raw = (uint64_t)(uintptr_t)va_arg(args, void*); break;
+            case LOG_ARG_DOUBLE: {
+                double value = va_arg(args, double);
+                memcpy(&raw, &value, sizeof(raw));
+                break;
+            }
+            case LOG_ARG_LDOUBLE: {
+                long double value = va_arg(args, long double);
+                memcpy(out, &value, sizeof(value));
+                out += sizeof(value);
+                continue;
+            }
+            case LOG_ARG_STRING: {
+                const char* str = va_arg(args, const char*);
+                if (!str) str = "(null)";
+                uint16_t len = (uint16_t)strnlen(str, LOGGER_MAX_STRING);
+                memcpy(out, &len, sizeof(len));
+                memcpy(out + sizeof(len), str, len);
+                out += sizeof(len) + len;
+                continue;
+            }
+        }
+        memcpy(out, &raw, sizeof(raw));
+        out += sizeof(raw);
+    }
+    
+    return (size_t)(out - start);
+}
+
+// ==================== FLOOD CONTROL ====================
+// Summary lines, one site per level so they keep the level of the source
+#define LOGGER_SUMMARY_SITES(fmt) { \
+    { .format = fmt, .file = "", .level = LOG_LEVEL_DEBUG, .module = LOG_MODULE_APP }, \
+    { .format = fmt, .file = "", .level = LOG_LEVEL_INFO, .module = LOG_MODULE_APP }, \
+    { .format = fmt, .file = "", .level = LOG_LEVEL_WARN, .module = LOG_MODULE_APP }, \
+    { .format = fmt, .file = "", .level = LOG_LEVEL_ERROR, .module = LOG_MODULE_APP }, \
+    { .format = fmt, .file = "", .level = LOG_LEVEL_FATAL, .module = LOG_MODULE_APP } }
+
+static log_site_t logger_repeat_sites[] =
+    LOGGER_SUMMARY_SITES("(%s:%d) last message repeated %u times");
+static log_site_t logger_dropped_sites[] =
+    LOGGER_SUMMARY_SITES("(%s:%d) %u messages dropped by rate limit");
+
+// Every LOG_*_LIMITED site used so far; sites are static, so the list only grows
+static _Atomic(log_site_t*) logger_limited_sites = NULL;
+
+static void logger_dispatch(log_site_t* site, va_list args);
+
+static uint32_t logger_hash(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u; // FNV-1a
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static void logger_lock_limit(log_limit_t* limit) {
+    while (atomic_flag_test_and_set_explicit(&limit->lock, memory_order_acquire)) {
+        // Held for a few compares
+    }
+}
+
+static void logger_unlock_limit(log_limit_t* limit) {
+    atomic_flag_clear_explicit(&limit->lock, memory_order_release);
+}
+
+// Write a summary line; 'direct' bypasses the async queue (used from logger_poll)
+static void logger_write_summary(bool direct, log_site_t* summary, ...) {
+    va_list args;
+    va_start(args, summary);
+    
+    if (direct && logger_site_prepare(summary)) {
+        uint8_t packed[LOGGER_MAX_ARGS_SIZE];
+        logger_site_pack_args(summary, args, packed);
+        logger_emit_record(summary, logger_timestamp_us(), packed);
+    } else {
+        logger_dispatch(summary, args);
+    }
+    
+    va_end(args);
+}
+
+static void logger_report_held(const log_site_t* site, uint32_t repeats, uint32_t dropped,
+                               bool direct) {
+    const char* filename = strrchr(site->file, '/');
+    filename = filename ? filename + 1 : site->file;
+    
+    if (repeats > 0) {
+        logger_write_summary(direct, &logger_repeat_sites[site->level],
+                             filename, site->line, (unsigned)repeats);
+    }
+    if (dropped > 0) {
+        logger_write_summary(direct, &logger_dropped_sites[site->level],
+                             filename, site->line, (unsigned)dropped);
+    }
+}
+
+// Take the held-back counts of a site if any are due; limit lock held
+static bool logger_take_held(log_limit_t* limit, uint64_t now, bool force,
+                             uint32_t* repeats, uint32_t* dropped) {
+    if (limit->repeats == 0 && limit->dropped == 0) return false;
+    if (!force && now - limit->held_us < (uint64_t)LOGGER_SUPPRESS_REPORT_MS * 1000u) return false;
+    
+    *repeats = limit->repeats;
+    *dropped = limit->dropped;
+    limit->repeats = 0;
+    limit->dropped = 0;
+    return true;
+}
+
+// Token bucket and repeat check for a LOG_*_LIMITED site; false = hold back
+static bool logger_site_admit(log_site_t* site, va_list args) {
+    uint64_t now = logger_timestamp_us();
+    uint32_t hash = 0;
+    bool hashed = false;
+    
+    // Lines are compared by their raw arguments; the format is the site's own
+    if (logger_site_prepare(site)) {
+        uint8_t packed[LOGGER_MAX_ARGS_SIZE];
+        va_list copy;
+        va_copy(copy, args);
+        size_t size = logger_site_pack_args(site, copy, packed);
+        va_end(copy);
+        hash = logger_hash(packed, size);
+        hashed = true;
+    }
+    
+    log_limit_t* limit = site->limit;
+    logger_lock_limit(limit);
+    
+    if (!limit->listed) {
+        limit->listed = true;
+        limit->tokens = (uint32_t)limit->burst * 1000u;
+        limit->refill_us = now;
+        limit->next = atomic_load(&logger_limited_sites);
+        while (!atomic_compare_exchange_weak(&logger_limited_sites, &limit->next, site)) {
+            // Another site registered first; retry on top of it
+        }
+    }
+    
+    // Refill: one thousandth of a line per refill_ms microseconds
+    uint32_t capacity = (uint32_t)limit->burst * 1000u;
+    if (limit->refill_ms > 0) {
+        uint64_t earned = (now - limit->refill_us) / limit->refill_ms;
+        if (limit->tokens + earned >= capacity) {
+            limit->tokens = capacity;
+            limit->refill_us = now;
+        } else if (earned > 0) {
+            limit->tokens += (uint32_t)earned;
+            limit->refill_us += earned * limit->refill_ms;
+        }
+    }
+    
+    bool admit = true;
+    if (hashed && limit->has_last && hash == limit->last_hash) {
+        if (limit->repeats == 0 && limit->dropped == 0) limit->held_us = now;
+        limit->repeats++;
+        admit = false;
+    } else if (limit->refill_ms > 0 && limit->tokens < 1000u) {
+        if (limit->repeats == 0 && limit->dropped == 0) limit->held_us = now;
+        limit->dropped++;
+        admit = false;
+    }
+    
+    // A line that goes out first reports what was held back before it;
+    // one that keeps being held reports every LOGGER_SUPPRESS_REPORT_MS
+    uint32_t repeats = 0, dropped = 0;
+    bool report = logger_take_held(limit, now, admit, &repeats, &dropped);
+    
+    if (admit) {
+        if (limit->refill_ms > 0) limit->tokens -= 1000u;
+        limit->last_hash = hash;
+        limit->has_last = hashed;
+    }
+    
+    logger_unlock_limit(limit);
+    
+    if (report) {
+        logger_report_held(site, repeats, dropped, false);
+    }
+    return admit;
+}
+
+// Report held-back lines of sites that have gone quiet
+static void logger_report_quiet_sites(uint64_t now) {
+    for (log_site_t* site = atomic_load(&logger_limited_sites); site; site = site->limit->next) {
+        uint32_t repeats = 0, dropped = 0;
+        
+        logger_lock_limit(site->limit);
+        bool report = logger_take_held(site->limit, now, false, &repeats, &dropped);
+        logger_unlock_limit(site->limit);
+        
+        if (report) {
+            logger_report_held(site, repeats, dropped, true);
+        }
+    }
+}
+
+// ==================== OUTPUT ====================
+static log_sink_t* logger_sinks[LOGGER_MAX_SINKS];
+static uint32_t logger_sink_count = 0;
+
+static char logger_write_buffer[LOGGER_WRITE_BUFFER_SIZE];
+static size_t logger_write_used = 0;
+static uint64_t logger_oldest_us = 0;          // When the first buffered line arrived
+
+// A real lock, not a spin: the holder may sit in a sink's write, flush or
+// file rotation for as long as the storage takes
+#ifdef _WIN32
+static SRWLOCK logger_output_lock = SRWLOCK_INIT;
+#else
+static pthread_mutex_t logger_output_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static logger_flush_policy_t logger_flush_policy = {
+    .flush_bytes = LOGGER_WRITE_BUFFER_SIZE,
+    .flush_interval_ms = 100,
+    .flush_level = LOG_LEVEL_ERROR
+};
+
+static void logger_lock_output(void) {
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&logger_output_lock);
+#else
+    pthread_mutex_lock(&logger_output_lock);
+#endif
+}
+
+static void logger_unlock_output(void) {
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(&logger_output_lock);
+#else
+    pthread_mutex_unlock(&logger_output_lock);
+#endif
+}
+
+// Hand the write buffer to the sinks; caller holds the output lock
+static void logger_flush_locked(void) {
+    if (logger_write_used == 0) return;
+    
+    if (logger_sink_count == 0) {
+        FILE* out = logger_output();
+        fwrite(logger_write_buffer, 1, logger_write_used, out);
+        fflush(out);
+    }
+    
+    for (uint32_t i = 0; i < logger_sink_count; i++) {
+        log_sink_t* sink = logger_sinks[i];
+        sink->write(sink, logger_write_buffer, logger_write_used);
+        sink->bytes_written += logger_write_used;
+        sink->write_calls++;
+        if (sink->flush) sink->flush(sink);
+    }
+    
+    logger_write_used = 0;
+}
+
+void logger_output_text(log_level_t level, const char* text, size_t length) {
+    uint64_t now = logger_timestamp_us();
+    
+    logger_lock_output();
+    
+    if (logger_write_used + length > sizeof(logger_write_buffer)) {
+        logger_flush_locked();
+    }
+    
+    if (length > sizeof(logger_write_buffer)) {
+        length = sizeof(logger_write_buffer);
+    }
+    
+    if (logger_write_used == 0) {
+        logger_oldest_us = now;
+    }
+    memcpy(logger_write_buffer + logger_write_used, text, length);
+    logger_write_used += length;
+    
+    if (level >= logger_flush_policy.flush_level ||
+        logger_write_used >= logger_flush_policy.flush_bytes ||
+        now - logger_oldest_us >= (uint64_t)logger_flush_policy.flush_interval_ms * 1000u) {
+        logger_flush_locked();
+    }
+    
+    logger_unlock_output();
+}
+
+void logger_flush(void) {
+    logger_lock_output();
+    logger_flush_locked();
+    logger_unlock_output();
+}
+
+void logger_poll(void) {
+    uint64_t now = logger_timestamp_us();
+    
+    logger_report_quiet_sites(now);
+    
+    logger_lock_output();
+    if (logger_write_used > 0 &&
+        now - logger_oldest_us >= (uint64_t)logger_flush_policy.flush_interval_ms * 1000u) {
+        logger_flush_locked();
+    }
+    logger_unlock_output();
+}
+
+void logger_set_flush_policy(const logger_flush_policy_t* policy) {
+    if (!policy) return;
+    
+    logger_lock_output();
+    logger_flush_policy = *policy;
+    logger_flush_locked();
+    logger_unlock_output();
+}
+
+bool logger_add_sink(log_sink_t* sink) {
+    if (!sink || !sink->write) return false;
+    
+    logger_lock_output();
+    
+    // Buffered lines belong to the sinks that were active when they arrived
+    logger_flush_locked();
+    
+    bool added = false;
+    if (logger_sink_count < LOGGER_MAX_SINKS) {
+        logger_sinks[logger_sink_count++] = sink;
+        added = true;
+    }
+    
+    logger_unlock_output();
+    
+    if (!added) {
+        printf("[LOGGER] Error: Too many sinks (max %d)\n", LOGGER_MAX_SINKS);
+    }
+    return added;
+}
+
+bool logger_remove_sink(log_sink_t* sink) {
+    bool removed = false;
+    
+    logger_lock_output();
+    logger_flush_locked();
+    
+    for (uint32_t i = 0; i < logger_sink_count; i++) {
+        if (logger_sinks[i] == sink) {
+            logger_sinks[i] = logger_sinks[--logger_sink_count];
+            removed = true;
+            break;
+        }
+    }
+    
+    logger_unlock_output();
+    return removed;
+}
+
+void logger_emit_line(log_level_t level, const char* file, int line,
+                      uint64_t timestamp_us, const char* message) {
+    char text[LOGGER_LINE_MAX];
+    int len = 0;
     
     // Print timestamp
     if (logger_config.enable_timestamp) {
-        fprintf(logger_config.output_stream, "[%02d:%02d:%02d] ", 
-                timeinfo->tm_hour, timeinfo->tm_min, timeinfo->tm_sec);
+        len += logger_format_timestamp(text + len, timestamp_us);
     }
     
     // Print log level with color
     if (logger_config.enable_level) {
-        fprintf(logger_config.output_stream, "%s[%5s]\033[0m ", 
-                logger_level_to_color(level), logger_level_to_string(level));
+        len += snprintf(text + len, sizeof(text) - len, "%s[%5s]\033[0m ",
+                        logger_level_to_color(level), logger_level_to_string(level));
     }
     
     // Print file and line number
-    if (logger_config.enable_file_line) {
+    if (logger_config.enable_file_line && file && *file) {
         const char* filename = strrchr(file, '/');
         if (!filename) filename = file;
         else filename++;
         
-        fprintf(logger_config.output_stream, "(%s:%d) ", filename, line);
+        len += snprintf(text + len, sizeof(text) - len, "(%s:%d) ", filename, line);
     }
     
-    // Print the message
+    if (len > (int)sizeof(text) - 2) len = (int)sizeof(text) - 2;
+    
+    // Message and newline, written with a single call so lines never interleave
+    len += snprintf(text + len, sizeof(text) - len - 1, "%s", message);
+    if (len > (int)sizeof(text) - 2) len = (int)sizeof(text) - 2;
+    text[len++] = '\n';
+    
+    // Whole lines go into the write buffer, so sinks never see a partial one
+    logger_output_text(level, text, (size_t)len);
+}
+
+void logger_emit_record(const log_site_t* site, uint64_t timestamp_us, const uint8_t* args) {
+    if (logger_binary_is_active()) {
+        logger_binary_write(site, timestamp_us, args);
+        return;
+    }
+    
+    char message[LOGGER_LINE_MAX];
+    logger_format_render(site->format, site->arg_types, site->arg_count, args,
+                         message, sizeof(message));
+    logger_emit_line(site->level, site->file, site->line, timestamp_us, message);
+}
+
+void logger_log(log_level_t level, const char* file, int line, const char* format, ...) {
+    // Check if we should log this message
+    if (level < logger_config.min_level) {
+        return;
+    }
+    
+    char message[LOGGER_LINE_MAX];
     va_list args;
     va_start(args, format);
-    vfprintf(logger_config.output_stream, format, args);
+    vsnprintf(message, sizeof(message), format, args);
     va_end(args);
     
-    // New line
-    fprintf(logger_config.output_stream, "\n");
+    logger_emit_line(level, file, line, logger_timestamp_us(), message);
+}
+
+static void logger_dispatch(log_site_t* site, va_list args) {
+    // Hot path: hand the raw arguments to the background formatter
+    if (logger_async_is_running() && logger_async_enqueue(site, args)) {
+        return;
+    }
+    
+    // Binary output keeps the raw arguments; nothing is formatted
+    if (logger_binary_is_active() && logger_site_prepare(site)) {
+        uint8_t packed[LOGGER_MAX_ARGS_SIZE];
+        logger_site_pack_args(site, args, packed);
+        logger_binary_write(site, logger_timestamp_us(), packed);
+        return;
+    }
+    
+    char message[LOGGER_LINE_MAX];
+    vsnprintf(message, sizeof(message), site->format, args);
+    
+    logger_emit_line(site->level, site->file, site->line, logger_timestamp_us(), message);
+}
+
+void logger_write(log_site_t* site, ...) {
+    // Level already checked by the LOG_* macro against the module threshold
+    va_list args;
+    va_start(args, site);
+    
+    if (!site->limit || logger_site_admit(site, args)) {
+        flight_recorder_log(site, args);
+        logger_dispatch(site, args);
+    }
     
-    // Flush for immediate output
-    fflush(logger_config.output_stream);
+    va_end(args);
 }
 
 void logger_hex_dump(const char* label, const void* data, size_t size) {
@@ -104,41 +773,26 @@ void logger_hex_dump(const char* label, const void* data, size_t size) {
         return;
     }
     
-    const unsigned char* bytes = (const unsigned char*)data;
+    const uint8_t* bytes = (const uint8_t*)data;
+    char block[LOGGER_LINE_MAX + HEX_DUMP_SIZE(LOGGER_HEX_DUMP_BLOCK)];
     
-    fprintf(logger_config.output_stream, "%s (%zu bytes):\n", label, size);
+    // Let queued asynchronous records go out first
+    logger_async_flush();
     
-    for (size_t i = 0; i < size; i += 16) {
-        // Print offset
-        fprintf(logger_config.output_stream, "  %04zx: ", i);
-        
-        // Print hex
-        for (size_t j = 0; j < 16; j++) {
-            if (i + j < size) {
-                fprintf(logger_config.output_stream, "%02x ", bytes[i + j]);
-            } else {
-                fprintf(logger_config.output_stream, "   ");
-            }
-            
-            if (j == 7) {
-                fprintf(logger_config.output_stream, " ");
-            }
-        }
-        
-        fprintf(logger_config.output_stream, " ");
-        
-        // Print ASCII
-        for (size_t j = 0; j < 16 && i + j < size; j++) {
-            unsigned char c = bytes[i + j];
-            if (c >= 32 && c <= 126) {
-                fprintf(logger_config.output_stream, "%c", c);
-            } else {
-                fprintf(logger_config.output_stream, ".");
-            }
-        }
-        
-        fprintf(logger_config.output_stream, "\n");
+    int len = snprintf(block, LOGGER_LINE_MAX, "%s (%zu bytes):\n", label, size);
+    size_t used = len < 0 ? 0 : (size_t)len < LOGGER_LINE_MAX ? (size_t)len : LOGGER_LINE_MAX - 1;
+    
+    // Rows are rendered a block at a time and written with one call
+    for (size_t i = 0; i < size; i += LOGGER_HEX_DUMP_BLOCK) {
+        size_t count = size - i < LOGGER_HEX_DUMP_BLOCK ? size - i : LOGGER_HEX_DUMP_BLOCK;
+        used += hex_dump_rows(block + used, bytes + i, count, i);
+        logger_output_text(LOG_LEVEL_DEBUG, block, used);
+        used = 0;
+    }
+    
+    if (used > 0) {
+        logger_output_text(LOG_LEVEL_DEBUG, block, used);
     }
     
-    fflush(logger_config.output_stream);
+    logger_flush();
 }
\ No newline at end of file
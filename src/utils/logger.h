@@ -2,8 +2,13 @@
 #define LOGGER_H
 
 #include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include <time.h>
 #include <stdarg.h>
+#include <stdatomic.h>
+#include "logger_format.h"
+#include "logger_sink.h"
 
 // Log levels
 typedef enum {
@@ -14,6 +19,27 @@ typedef enum {
     LOG_LEVEL_FATAL
 } log_level_t;
 
+// Compile-time floor: LOG_* calls below this level compile to nothing,
+// arguments included. 0 = DEBUG ... 4 = FATAL; release builds use 1.
+#ifndef LOGGER_COMPILE_LEVEL
+#define LOGGER_COMPILE_LEVEL 0
+#endif
+
+// Modules with their own runtime level
+typedef enum {
+    LOG_MODULE_KERNEL = 0,
+    LOG_MODULE_HAL,
+    LOG_MODULE_PROTOCOL,
+    LOG_MODULE_OTA,
+    LOG_MODULE_APP,
+    LOG_MODULE_COUNT
+} log_module_t;
+
+// Module of the LOG_* calls in a source file; define before use to change
+#ifndef LOG_MODULE
+#define LOG_MODULE LOG_MODULE_APP
+#endif
+
 // Log output options
 typedef struct {
     bool enable_timestamp;
@@ -24,25 +50,176 @@ typedef struct {
     FILE* output_stream;
 } logger_config_t;
 
+struct log_site;
+
+// Flood control state of one LOG_*_LIMITED call site: a token bucket of
+// 'burst' lines refilled one line per 'refill_ms', and repeats of the
+// last line held back and counted instead of written
+typedef struct log_limit {
+    uint16_t burst;
+    uint32_t refill_ms;                 // 0 = no rate limit, repeats only
+    atomic_flag lock;
+    bool listed;                        // On the list logger_poll walks
+    uint32_t tokens;                    // In thousandths of a line
+    uint64_t refill_us;
+    bool has_last;
+    uint32_t last_hash;                 // Arguments of the last line written
+    uint32_t repeats;                   // Identical lines held back since
+    uint32_t dropped;                   // Other lines refused by the bucket
+    uint64_t held_us;                   // When the first of those arrived
+    struct log_site* next;              // Next limited site on that list
+} log_limit_t;
+
+// Static description of one LOG_* call site. The format string is parsed
+// once, on first use, into the argument types the async and binary paths
+// have to copy.
+typedef struct log_site {
+    const char* format;
+    const char* file;
+    int line;
+    log_level_t level;
+    uint8_t module;                     // log_module_t
+    atomic_uchar parse_state;           // 0 = new, 1 = parsing, 2 = ready
+    uint8_t arg_count;
+    uint8_t arg_types[LOGGER_MAX_ARGS];
+    bool has_strings;
+    uint16_t fixed_size;                // Raw argument bytes, %s excluded
+    log_limit_t* limit;                 // LOG_*_LIMITED sites only, else NULL
+} log_site_t;
+
 // Initialize logger
 void logger_init(logger_config_t* config);
 
 // Set minimum log level
 void logger_set_level(log_level_t level);
 
+// Per-module level; overrides the global level for that module
+void logger_set_module_level(log_module_t module, log_level_t level);
+
+// Make a module follow the global level again
+void logger_clear_module_level(log_module_t module);
+
+// Get the level currently in effect for a module
+log_level_t logger_get_module_level(log_module_t module);
+
+// Effective level of each module, cached so a LOG_* call costs one
+// compare against one byte. Updated by the setters above; read-only here.
+extern uint8_t logger_module_threshold[LOG_MODULE_COUNT];
+
 // Log functions
 void logger_log(log_level_t level, const char* file, int line, const char* format, ...);
+void logger_write(log_site_t* site, ...);
+
+// Output: formatted lines collect in one shared write buffer that is
+// handed to every sink at once. With no sink added, the buffer goes to
+// logger_config_t.output_stream.
+#define LOGGER_WRITE_BUFFER_SIZE    4096
+#define LOGGER_MAX_SINKS            4
+
+// When the write buffer is passed on to the sinks
+typedef struct {
+    size_t flush_bytes;             // Once this many bytes are buffered
+    uint32_t flush_interval_ms;     // Once the oldest buffered line is this old
+    log_level_t flush_level;        // Immediately for lines at this level or above
+} logger_flush_policy_t;
+
+// Set the flush policy (default: full buffer, 100 ms, ERROR)
+void logger_set_flush_policy(const logger_flush_policy_t* policy);
+
+// Add / remove an output sink
+bool logger_add_sink(log_sink_t* sink);
+bool logger_remove_sink(log_sink_t* sink);
+
+// Write out everything buffered now
+void logger_flush(void);
+
+// Apply the interval policy and report lines held back by LOG_*_LIMITED
+// sites that went quiet; call periodically when logging is idle
+void logger_poll(void);
+
+// How long a LOG_*_LIMITED site may hold lines back before reporting
+// "last message repeated N times" / "N messages dropped by rate limit"
+#define LOGGER_SUPPRESS_REPORT_MS   30000
+
+// Monotonic microseconds since the logger was first used
+uint64_t logger_timestamp_us(void);
 
-// Convenience macros
-#define LOG_DEBUG(format, ...) logger_log(LOG_LEVEL_DEBUG, __FILE__, __LINE__, format, ##__VA_ARGS__)
-#define LOG_INFO(format, ...)  logger_log(LOG_LEVEL_INFO, __FILE__, __LINE__, format, ##__VA_ARGS__)
-#define LOG_WARN(format, ...)  logger_log(LOG_LEVEL_WARN, __FILE__, __LINE__, format, ##__VA_ARGS__)
-#define LOG_ERROR(format, ...) logger_log(LOG_LEVEL_ERROR, __FILE__, __LINE__, format, ##__VA_ARGS__)
-#define LOG_FATAL(format, ...) logger_log(LOG_LEVEL_FATAL, __FILE__, __LINE__, format, ##__VA_ARGS__)
+// Asynchronous mode: LOG_* calls only copy the site pointer and raw
+// arguments into a per-thread lock-free ring; a background thread formats
+// and writes them. Strings are copied (up to LOGGER_MAX_STRING bytes), so
+// the arguments may go away as soon as the call returns. At most
+// LOGGER_MAX_THREADS threads hold a ring at once; a ring is freed for reuse
+// once its thread has exited and the consumer has drained it. Calls from
+// further threads are written synchronously and counted by
+// logger_async_fallbacks().
+#define LOGGER_THREAD_BUFFER_SIZE   (64u * 1024u)
+#define LOGGER_MAX_THREADS          16
+
+bool logger_async_start(void);
+void logger_async_stop(void);
+void logger_async_flush(void);
+bool logger_async_is_running(void);
+uint32_t logger_async_dropped(void);
+uint32_t logger_async_fallbacks(void);
+
+// Convenience macros (the format must be a string literal). The level
+// filter lives here, so filtered calls never evaluate their arguments.
+#define LOGGER_SITE_LOG(lvl, fmt, ...) do { \
+        if ((lvl) >= LOGGER_COMPILE_LEVEL && \
+            (uint8_t)(lvl) >= logger_module_threshold[LOG_MODULE]) { \
+            static log_site_t logger_site_ = { .format = (fmt), .file = __FILE__, \
+                .line = __LINE__, .level = (lvl), .module = LOG_MODULE }; \
+            logger_write(&logger_site_, ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+// Same, with flood control: at most 'burst' lines at once, then one per
+// 'refill_ms'; a line identical to the previous one from this site is
+// only counted. The flood control state is a second static next to the
+// call site's, so plain sites do not carry it; nothing is allocated.
+#define LOGGER_SITE_LOG_LIMITED(lvl, brst, refill, fmt, ...) do { \
+        if ((lvl) >= LOGGER_COMPILE_LEVEL && \
+            (uint8_t)(lvl) >= logger_module_threshold[LOG_MODULE]) { \
+            static log_limit_t logger_limit_ = { .burst = (brst), .refill_ms = (refill) }; \
+            static log_site_t logger_site_ = { .format = (fmt), .file = __FILE__, \
+                .line = __LINE__, .level = (lvl), .module = LOG_MODULE, \
+                .limit = &logger_limit_ }; \
+            logger_write(&logger_site_, ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(format, ...) LOGGER_SITE_LOG(LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#define LOG_INFO(format, ...)  LOGGER_SITE_LOG(LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#define LOG_WARN(format, ...)  LOGGER_SITE_LOG(LOG_LEVEL_WARN, format, ##__VA_ARGS__)
+#define LOG_ERROR(format, ...) LOGGER_SITE_LOG(LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#define LOG_FATAL(format, ...) LOGGER_SITE_LOG(LOG_LEVEL_FATAL, format, ##__VA_ARGS__)
+
+#define LOG_DEBUG_LIMITED(burst, refill_ms, format, ...) \
+    LOGGER_SITE_LOG_LIMITED(LOG_LEVEL_DEBUG, burst, refill_ms, format, ##__VA_ARGS__)
+#define LOG_INFO_LIMITED(burst, refill_ms, format, ...) \
+    LOGGER_SITE_LOG_LIMITED(LOG_LEVEL_INFO, burst, refill_ms, format, ##__VA_ARGS__)
+#define LOG_WARN_LIMITED(burst, refill_ms, format, ...) \
+    LOGGER_SITE_LOG_LIMITED(LOG_LEVEL_WARN, burst, refill_ms, format, ##__VA_ARGS__)
+#define LOG_ERROR_LIMITED(burst, refill_ms, format, ...) \
+    LOGGER_SITE_LOG_LIMITED(LOG_LEVEL_ERROR, burst, refill_ms, format, ##__VA_ARGS__)
 
 // Helper functions
 const char* logger_level_to_string(log_level_t level);
 const char* logger_level_to_color(log_level_t level);
+const char* logger_module_to_string(log_module_t module);
 void logger_hex_dump(const char* label, const void* data, size_t size);
 
+// Internal: shared between the synchronous and asynchronous paths
+log_level_t logger_min_level(void);
+FILE* logger_output(void);
+void logger_emit_line(log_level_t level, const char* file, int line,
+                      uint64_t timestamp_us, const char* message);
+void logger_output_text(log_level_t level, const char* text, size_t length);
+bool logger_async_enqueue(log_site_t* site, va_list args);
+uint64_t logger_wall_clock_base_us(void);
+bool logger_site_prepare(log_site_t* site);
+size_t logger_site_args_size(const log_site_t* site, va_list args);
+size_t logger_site_pack_args(const log_site_t* site, va_list args, uint8_t* out);
+void logger_emit_record(const log_site_t* site, uint64_t timestamp_us, const uint8_t* args);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,277 @@
+#include "logger.h"
+#include "bip_buffer.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// ==================== RECORD FORMAT ====================
+// [header][raw argument block, see logger_format.h]
+typedef struct {
+    const log_site_t* site;
+    uint64_t timestamp_us;
+    uint16_t size;              // Whole record, header included
+} log_record_header_t;
+
+// Per-thread producer ring, claimed on a thread's first async log call and
+// handed back by the consumer once its thread has exited and it is drained
+typedef struct {
+    bip_buffer_t ring;
+    atomic_bool claimed;
+    atomic_bool ready;
+    atomic_bool released;       // Owner thread exited
+    atomic_uint dropped;
+} log_thread_buffer_t;
+
+static log_thread_buffer_t log_thread_buffers[LOGGER_MAX_THREADS];
+static _Thread_local log_thread_buffer_t* log_local_buffer = NULL;
+
+static atomic_bool async_running = false;
+static atomic_flag drain_lock = ATOMIC_FLAG_INIT;
+static uint32_t dropped_reported = 0;
+static atomic_uint sync_fallbacks = 0;
+
+#ifdef _WIN32
+static HANDLE consumer_thread;
+static DWORD thread_exit_key = FLS_OUT_OF_INDEXES;
+#else
+static pthread_t consumer_thread;
+static pthread_key_t thread_exit_key;
+static bool thread_exit_key_created = false;
+#endif
+
+// ==================== PRODUCER ====================
+// Runs on thread exit for threads that claimed a ring
+#ifdef _WIN32
+static void WINAPI log_thread_exit(PVOID arg) {
+#else
+static void log_thread_exit(void* arg) {
+#endif
+    log_thread_buffer_t* buffer = (log_thread_buffer_t*)arg;
+    log_local_buffer = NULL;
+    if (buffer) atomic_store_explicit(&buffer->released, true, memory_order_release);
+}
+
+static log_thread_buffer_t* log_thread_buffer(void) {
+    if (log_local_buffer) return log_local_buffer;
+    
+    for (int i = 0; i < LOGGER_MAX_THREADS; i++) {
+        log_thread_buffer_t* buffer = &log_thread_buffers[i];
+        bool expected = false;
+        if (!atomic_compare_exchange_strong(&buffer->claimed, &expected, true)) continue;
+        
+        if (!bip_buffer_init(&buffer->ring, LOGGER_THREAD_BUFFER_SIZE)) {
+            atomic_store(&buffer->claimed, false);
+            return NULL;
+        }
+        atomic_store_explicit(&buffer->ready, true, memory_order_release);
+        log_local_buffer = buffer;
+#ifdef _WIN32
+        FlsSetValue(thread_exit_key, buffer);
+#else
+        pthread_setspecific(thread_exit_key, buffer);
+#endif
+        return buffer;
+    }
+    
+    // More live logging threads than buffers: caller logs synchronously
+    atomic_fetch_add_explicit(&sync_fallbacks, 1, memory_order_relaxed);
+    return NULL;
+}
+
+bool logger_async_enqueue(log_site_t* site, va_list args) {
+    if (!logger_site_prepare(site)) return false;
+    
+    log_thread_buffer_t* buffer = log_thread_buffer();
+    if (!buffer) return false;
+    
+    size_t size = sizeof(log_record_header_t) + logger_site_args_size(site, args);
+    uint8_t* record = bip_buffer_reserve(&buffer->ring, size);
+    if (!record) {
+        // Never block the caller: count it and let the consumer report it
+        atomic_fetch_add_explicit(&buffer->dropped, 1, memory_order_relaxed);
+        return true;
+    }
+    
+    log_record_header_t header = { site, logger_timestamp_us(), (uint16_t)size };
+    memcpy(record, &header, sizeof(header));
+    logger_site_pack_args(site, args, record + sizeof(header));
+    
+    bip_buffer_commit(&buffer->ring, size);
+    return true;
+}
+
+// ==================== CONSUMER ====================
+// Drain every thread's ring; returns the number of records written
+static uint32_t log_drain(void) {
+    if (atomic_flag_test_and_set_explicit(&drain_lock, memory_order_acquire)) {
+        return 0; // Someone else is draining
+    }
+    
+    uint32_t records = 0;
+    uint32_t dropped = 0;
+    
+    for (int i = 0; i < LOGGER_MAX_THREADS; i++) {
+        log_thread_buffer_t* buffer = &log_thread_buffers[i];
+        if (!atomic_load_explicit(&buffer->ready, memory_order_acquire)) continue;
+        
+        dropped += atomic_load_explicit(&buffer->dropped, memory_order_relaxed);
+        
+        size_t available = 0;
+        const uint8_t* block;
+        while ((block = bip_buffer_read(&buffer->ring, &available)) != NULL) {
+            size_t offset = 0;
+            while (offset + sizeof(log_record_header_t) <= available) {
+                log_record_header_t header;
+                memcpy(&header, block + offset, sizeof(header));
+                
+                logger_emit_record(header.site, header.timestamp_us,
+                                   block + offset + sizeof(header));
+                
+                offset += header.size;
+                records++;
+            }
+            bip_buffer_release(&buffer->ring, offset);
+        }
+        
+        // The owner is gone and everything it wrote is out: free the slot
+        if (atomic_load_explicit(&buffer->released, memory_order_acquire) &&
+            bip_buffer_is_empty(&buffer->ring)) {
+            atomic_store_explicit(&buffer->ready, false, memory_order_relaxed);
+            bip_buffer_destroy(&buffer->ring);
+            atomic_store_explicit(&buffer->released, false, memory_order_relaxed);
+            atomic_store_explicit(&buffer->claimed, false, memory_order_release);
+        }
+    }
+    
+    if (dropped != dropped_reported) {
+        char message[64];
+        snprintf(message, sizeof(message), "[LOGGER] %u messages dropped (ring full)",
+                 dropped - dropped_reported);
+        logger_emit_line(LOG_LEVEL_WARN, NULL, 0, logger_timestamp_us(), message);
+        dropped_reported = dropped;
+    }
+    
+    atomic_flag_clear_explicit(&drain_lock, memory_order_release);
+    return records;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI log_consumer(LPVOID arg) {
+#else
+static void* log_consumer(void* arg) {
+#endif
+    (void)arg;
+    
+    while (atomic_load_explicit(&async_running, memory_order_acquire)) {
+        if (log_drain() == 0) {
+            logger_poll();
+#ifdef _WIN32
+            Sleep(1);
+#else
+            usleep(1000);
+#endif
+        }
+    }
+    
+    return 0;
+}
+
+// ==================== CONTROL ====================
+bool logger_async_start(void) {
+    if (atomic_load(&async_running)) return true;
+    
+    // Lets the consumer take back the rings of threads that have exited
+#ifdef _WIN32
+    if (thread_exit_key == FLS_OUT_OF_INDEXES) {
+        thread_exit_key = FlsAlloc(log_thread_exit);
+        if (thread_exit_key == FLS_OUT_OF_INDEXES) {
+#else
+    if (!thread_exit_key_created) {
+        thread_exit_key_created = pthread_key_create(&thread_exit_key, log_thread_exit) == 0;
+        if (!thread_exit_key_created) {
+#endif
+            printf("[LOGGER] Error: Failed to create thread exit key\n");
+            return false;
+        }
+    }
+    
+    atomic_store(&async_running, true);
+
+#ifdef _WIN32
+    consumer_thread = CreateThread(NULL, 0, log_consumer, NULL, 0, NULL);
+    if (consumer_thread == NULL) {
+#else
+    if (pthread_create(&consumer_thread, NULL, log_consumer, NULL) != 0) {
+#endif
+        atomic_store(&async_running, false);
+        printf("[LOGGER] Error: Failed to start async consumer\n");
+        return false;
+    }
+    
+    printf("[LOGGER] Async mode started (%u KB per thread)\n",
+           LOGGER_THREAD_BUFFER_SIZE / 1024u);
+    return true;
+}
+
+void logger_async_stop(void) {
+    if (!atomic_load(&async_running)) return;
+    
+    atomic_store(&async_running, false);
+
+#ifdef _WIN32
+    WaitForSingleObject(consumer_thread, INFINITE);
+    CloseHandle(consumer_thread);
+#else
+    pthread_join(consumer_thread, NULL);
+#endif
+
+    // Whatever was queued before the stop still gets written
+    log_drain();
+    logger_flush();
+    printf("[LOGGER] Async mode stopped\n");
+}
+
+void logger_async_flush(void) {
+    // Keep going until every ring is empty and the rings of exited threads
+    // are free again (waits out a concurrent drain)
+    while (1) {
+        bool empty = true;
+        for (int i = 0; i < LOGGER_MAX_THREADS; i++) {
+            log_thread_buffer_t* buffer = &log_thread_buffers[i];
+            if (atomic_load_explicit(&buffer->ready, memory_order_acquire) &&
+                (!bip_buffer_is_empty(&buffer->ring) ||
+                 atomic_load_explicit(&buffer->released, memory_order_acquire))) {
+                empty = false;
+                break;
+            }
+        }
+        if (empty) {
+            logger_flush();
+            return;
+        }
+        
+        log_drain();
+    }
+}
+
+bool logger_async_is_running(void) {
+    return atomic_load_explicit(&async_running, memory_order_relaxed);
+}
+
+uint32_t logger_async_dropped(void) {
+    uint32_t dropped = 0;
+    for (int i = 0; i < LOGGER_MAX_THREADS; i++) {
+        dropped += atomic_load_explicit(&log_thread_buffers[i].dropped, memory_order_relaxed);
+    }
+    return dropped;
+}
+
+uint32_t logger_async_fallbacks(void) {
+    return atomic_load_explicit(&sync_fallbacks, memory_order_relaxed);
+}
\ No newline at end of file
@@ -0,0 +1,222 @@
+#include "logger_binary.h"
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+// Longest encoded entry: tag + id + delta + every argument at its widest
+#define LOGGER_BINARY_ENTRY_MAX     (32 + LOGGER_MAX_ARGS * (5 + LOGGER_MAX_STRING) + 512)
+
+// Site pointer -> dictionary id, open addressing
+typedef struct {
+    const log_site_t* site;
+    uint32_t id;
+} logger_binary_slot_t;
+
+static FILE* binary_out = NULL;
+static atomic_bool binary_active = false;
+#ifdef _WIN32
+static SRWLOCK binary_lock = SRWLOCK_INIT;
+#else
+static pthread_mutex_t binary_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+static logger_binary_slot_t binary_sites[LOGGER_BINARY_MAX_SITES];
+static uint32_t binary_next_id = 0;
+static uint64_t binary_last_timestamp = 0;
+
+// Writers block here rather than spin: the holder may be in fwrite/fflush
+static void binary_lock_acquire(void) {
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&binary_lock);
+#else
+    pthread_mutex_lock(&binary_lock);
+#endif
+}
+
+static void binary_lock_release(void) {
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(&binary_lock);
+#else
+    pthread_mutex_unlock(&binary_lock);
+#endif
+}
+
+// ==================== ENCODING ====================
+static size_t put_varint(uint8_t* out, uint64_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    return n;
+}
+
+static uint64_t zigzag(int64_t value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static size_t put_u64le(uint8_t* out, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        out[i] = (uint8_t)(value >> (8 * i));
+    }
+    return 8;
+}
+
+static size_t put_string(uint8_t* out, const char* str, size_t max) {
+    size_t len = str ? strlen(str) : 0;
+    if (len > max) len = max;
+    size_t n = put_varint(out, len);
+    memcpy(out + n, str, len);
+    return n + len;
+}
+
+static size_t put_format(uint8_t* out, const log_site_t* site, uint32_t id) {
+    size_t n = 0;
+    out[n++] = LOGGER_BINARY_TAG_FORMAT;
+    n += put_varint(out + n, id);
+    out[n++] = (uint8_t)site->level;
+    out[n++] = site->module;
+    n += put_varint(out + n, (uint64_t)site->line);
+    n += put_string(out + n, site->file, 200);
+    n += put_string(out + n, site->format, 250);
+    out[n++] = site->arg_count;
+    memcpy(out + n, site->arg_types, site->arg_count);
+    return n + site->arg_count;
+}
+
+// Re-encode a raw argument block: varints for integers, bytes for strings
+static size_t put_args(uint8_t* out, const log_site_t* site, const uint8_t* args) {
+    size_t n = 0;
+    for (uint8_t i = 0; i < site->arg_count; i++) {
+        uint8_t type = site->arg_types[i];
+        if (type == LOG_ARG_STRING) {
+            uint16_t len;
+            memcpy(&len, args, sizeof(len));
+            n += put_varint(out + n, len);
+            memcpy(out + n, args + sizeof(len), len);
+            n += len;
+            args += sizeof(len) + len;
+        } else if (type == LOG_ARG_DOUBLE || type == LOG_ARG_LDOUBLE) {
+            double value;
+            if (type == LOG_ARG_LDOUBLE) {
+                long double wide;
+                memcpy(&wide, args, sizeof(wide));
+                value = (double)wide;
+            } else {
+                memcpy(&value, args, sizeof(value));
+            }
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            n += put_u64le(out + n, bits);
+            args += logger_format_arg_size(type);
+        } else {
+            int64_t value;
+            memcpy(&value, args, sizeof(value));
+            n += put_varint(out + n, zigzag(value));
+            args += sizeof(value);
+        }
+    }
+    return n;
+}
+
+// Dictionary id for a site; *is_new is set when the FORMAT entry is due
+static uint32_t site_id(const log_site_t* site, bool* is_new) {
+    uintptr_t hash = ((uintptr_t)site >> 3) * 2654435761u;
+    for (uint32_t probe = 0; probe < LOGGER_BINARY_MAX_SITES; probe++) {
+        logger_binary_slot_t* slot = &binary_sites[(hash + probe) % LOGGER_BINARY_MAX_SITES];
+        if (slot->site == site) {
+            *is_new = false;
+            return slot->id;
+        }
+        if (slot->site == NULL) {
+            slot->site = site;
+            slot->id = binary_next_id++;
+            *is_new = true;
+            return slot->id;
+        }
+    }
+    
+    // Table full: a fresh id every time, with its FORMAT entry
+    *is_new = true;
+    return binary_next_id++;
+}
+
+// ==================== WRITER ====================
+bool logger_binary_start(FILE* out) {
+    if (!out) return false;
+    
+    logger_binary_stop();
+    
+    memset(binary_sites, 0, sizeof(binary_sites));
+    binary_next_id = 0;
+    binary_last_timestamp = 0;
+    
+    uint8_t header[16];
+    size_t n = sizeof(LOGGER_BINARY_MAGIC) - 1;
+    memcpy(header, LOGGER_BINARY_MAGIC, n);
+    header[n++] = LOGGER_BINARY_VERSION;
+    n += put_u64le(header + n, logger_wall_clock_base_us());
+    if (fwrite(header, 1, n, out) != n) {
+        printf("[LOGGER] Error: Failed to write binary log header\n");
+        return false;
+    }
+    
+    binary_out = out;
+    atomic_store_explicit(&binary_active, true, memory_order_release);
+    printf("[LOGGER] Binary output started\n");
+    return true;
+}
+
+void logger_binary_stop(void) {
+    if (!atomic_load(&binary_active)) return;
+    
+    binary_lock_acquire();
+    atomic_store_explicit(&binary_active, false, memory_order_release);
+    fflush(binary_out);
+    binary_out = NULL;
+    binary_lock_release();
+    
+    printf("[LOGGER] Binary output stopped\n");
+}
+
+bool logger_binary_is_active(void) {
+    return atomic_load_explicit(&binary_active, memory_order_acquire);
+}
+
+void logger_binary_write(const log_site_t* site, uint64_t timestamp_us, const uint8_t* args) {
+    uint8_t entry[LOGGER_BINARY_ENTRY_MAX];
+    
+    binary_lock_acquire();
+    
+    if (!binary_out) {
+        binary_lock_release();
+        return;
+    }
+    
+    size_t n = 0;
+    bool is_new;
+    uint32_t id = site_id(site, &is_new);
+    if (is_new) {
+        n += put_format(entry, site, id);
+    }
+    
+    // Records from different threads may arrive slightly out of order
+    int64_t delta = (int64_t)(timestamp_us - binary_last_timestamp);
+    binary_last_timestamp = timestamp_us;
+    
+    entry[n++] = LOGGER_BINARY_TAG_RECORD;
+    n += put_varint(entry + n, id);
+    n += put_varint(entry + n, zigzag(delta));
+    n += put_args(entry + n, site, args);
+    
+    fwrite(entry, 1, n, binary_out);
+    if (site->level >= LOG_LEVEL_ERROR) {
+        fflush(binary_out);
+    }
+    
+    binary_lock_release();
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#ifndef LOGGER_BINARY_H
+#define LOGGER_BINARY_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "logger.h"
+
+// Compact binary log stream. Format strings are written once, in a
+// dictionary entry, the first time a call site logs; each record after
+// that is a site id, a timestamp delta and the varint-encoded arguments.
+//
+// File header: "SHLOG" magic, version byte, wall-clock base (us, 8 bytes LE)
+// Entries start with a tag byte:
+//   FORMAT  varint id, level, module, varint line, file, format,
+//           argument count, argument types
+//   RECORD  varint id, zigzag varint timestamp delta (us), arguments
+// Strings are a varint length followed by the bytes. Integers and pointers
+// are zigzag varints of the sign-extended value; doubles (and long doubles,
+// narrowed) are 8 bytes LE.
+#define LOGGER_BINARY_MAGIC         "SHLOG"
+#define LOGGER_BINARY_VERSION       1
+#define LOGGER_BINARY_TAG_FORMAT    0x01
+#define LOGGER_BINARY_TAG_RECORD    0x02
+
+// Call sites remembered per stream; beyond this a site's format entry is
+// repeated with every record (still decodable, just larger)
+#define LOGGER_BINARY_MAX_SITES     1024
+
+// ==================== WRITER (logger_binary.c) ====================
+// Send LOG_* records to 'out' in binary form instead of as text lines.
+// Direct text output (hex dumps, logger messages) keeps its own stream.
+bool logger_binary_start(FILE* out);
+
+// Flush and stop binary output; LOG_* records go back to text
+void logger_binary_stop(void);
+
+// Check whether LOG_* records are currently written in binary
+bool logger_binary_is_active(void);
+
+// Encode one record (raw argument block as in logger_format.h)
+void logger_binary_write(const log_site_t* site, uint64_t timestamp_us, const uint8_t* args);
+
+// ==================== READER (logger_binary_reader.c) ====================
+// One dictionary entry as read back from a stream
+typedef struct {
+    bool defined;
+    uint8_t level;
+    uint8_t module;
+    uint32_t line;
+    char* file;
+    char* format;
+    uint8_t arg_count;
+    uint8_t arg_types[LOGGER_MAX_ARGS];
+} logger_binary_format_t;
+
+// Decoded record; 'args' is a raw argument block valid until the next read
+typedef struct {
+    const logger_binary_format_t* format;
+    uint64_t timestamp_us;      // Since the stream's time base
+    uint64_t wall_us;           // Unix time in microseconds
+    const uint8_t* args;
+} logger_binary_record_t;
+
+// Stream reader state (about 66 KB: keep it static or on the heap)
+typedef struct {
+    FILE* in;
+    uint8_t buffer[64 * 1024];
+    size_t pos;
+    size_t end;
+    uint64_t wall_base_us;
+    uint64_t timestamp_us;
+    logger_binary_format_t* formats;
+    uint32_t format_capacity;
+    uint8_t args[LOGGER_MAX_ARGS_SIZE];
+} logger_binary_reader_t;
+
+// Check the header and prepare to read records from 'in'
+bool logger_binary_reader_open(logger_binary_reader_t* reader, FILE* in);
+
+// Read the next record; false at end of stream or on corrupt data
+bool logger_binary_reader_next(logger_binary_reader_t* reader, logger_binary_record_t* record);
+
+// Rebuild a record's message text
+size_t logger_binary_render(const logger_binary_record_t* record, char* message, size_t space);
+
+// Release the reader's dictionary (does not close the file)
+void logger_binary_reader_close(logger_binary_reader_t* reader);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include "logger_binary.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ==================== INPUT ====================
+// Make at least 'need' bytes available at reader->pos (false at EOF)
+static bool reader_fill(logger_binary_reader_t* reader, size_t need) {
+    if (reader->end - reader->pos >= need) return true;
+    
+    size_t remaining = reader->end - reader->pos;
+    memmove(reader->buffer, reader->buffer + reader->pos, remaining);
+    reader->pos = 0;
+    reader->end = remaining;
+    
+    reader->end += fread(reader->buffer + reader->end, 1,
+                         sizeof(reader->buffer) - reader->end, reader->in);
+    return reader->end - reader->pos >= need;
+}
+
+static bool get_byte(logger_binary_reader_t* reader, uint8_t* value) {
+    if (!reader_fill(reader, 1)) return false;
+    *value = reader->buffer[reader->pos++];
+    return true;
+}
+
+static bool get_varint(logger_binary_reader_t* reader, uint64_t* value) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte;
+        if (!get_byte(reader, &byte)) return false;
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false; // Longer than any 64-bit value: corrupt
+}
+
+static int64_t unzigzag(uint64_t value) {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+static bool get_bytes(logger_binary_reader_t* reader, void* dest, size_t size) {
+    if (size > sizeof(reader->buffer) || !reader_fill(reader, size)) return false;
+    memcpy(dest, reader->buffer + reader->pos, size);
+    reader->pos += size;
+    return true;
+}
+
+static bool get_u64le(logger_binary_reader_t* reader, uint64_t* value) {
+    uint8_t bytes[8];
+    if (!get_bytes(reader, bytes, sizeof(bytes))) return false;
+    
+    *value = 0;
+    for (int i = 7; i >= 0; i--) {
+        *value = (*value << 8) | bytes[i];
+    }
+    return true;
+}
+
+static char* get_string(logger_binary_reader_t* reader) {
+    uint64_t len;
+    if (!get_varint(reader, &len) || len > 4096) return NULL;
+    
+    char* str = (char*)malloc((size_t)len + 1);
+    if (!str) return NULL;
+    if (!get_bytes(reader, str, (size_t)len)) {
+        free(str);
+        return NULL;
+    }
+    str[len] = '\0';
+    return str;
+}
+
+// ==================== ENTRIES ====================
+static bool read_format(logger_binary_reader_t* reader) {
+    uint64_t id, line;
+    uint8_t level, module, count;
+    
+    if (!get_varint(reader, &id) || id >= 0x1000000u) return false;
+    if (!get_byte(reader, &level) || !get_byte(reader, &module)) return false;
+    if (!get_varint(reader, &line)) return false;
+    
+    if (id >= reader->format_capacity) {
+        uint32_t capacity = reader->format_capacity ? reader->format_capacity : 64;
+        while (capacity <= id) capacity *= 2;
+        
+        logger_binary_format_t* formats = (logger_binary_format_t*)realloc(
+            reader->formats, capacity * sizeof(logger_binary_format_t));
+        if (!formats) return false;
+        memset(formats + reader->format_capacity, 0,
+               (capacity - reader->format_capacity) * sizeof(logger_binary_format_t));
+        reader->formats = formats;
+        reader->format_capacity = capacity;
+    }
+    
+    logger_binary_format_t* format = &reader->formats[id];
+    free(format->file);
+    free(format->format);
+    format->file = get_string(reader);
+    format->format = get_string(reader);
+    format->defined = false;
+    if (!format->file || !format->format) return false;
+    
+    if (!get_byte(reader, &count) || count > LOGGER_MAX_ARGS) return false;
+    if (!get_bytes(reader, format->arg_types, count)) return false;
+    
+    // The format goes to snprintf with these types: it must take exactly
+    // these arguments, and nothing like %n
+    if (!logger_format_check(format->format, format->arg_types, count)) return false;
+    
+    format->level = level;
+    format->module = module;
+    format->line = (uint32_t)line;
+    format->arg_count = count;
+    format->defined = true;
+    return true;
+}
+
+// Expand encoded arguments back into a raw argument block
+static bool read_args(logger_binary_reader_t* reader, const logger_binary_format_t* format) {
+    uint8_t* out = reader->args;
+    
+    for (uint8_t i = 0; i < format->arg_count; i++) {
+        uint8_t type = format->arg_types[i];
+        if (type == LOG_ARG_STRING) {
+            uint64_t len;
+            if (!get_varint(reader, &len) || len > LOGGER_MAX_STRING) return false;
+            uint16_t len16 = (uint16_t)len;
+            memcpy(out, &len16, sizeof(len16));
+            if (!get_bytes(reader, out + sizeof(len16), len16)) return false;
+            out += sizeof(len16) + len16;
+        } else if (type == LOG_ARG_DOUBLE || type == LOG_ARG_LDOUBLE) {
+            uint64_t bits;
+            double value;
+            if (!get_u64le(reader, &bits)) return false;
+            memcpy(&value, &bits, sizeof(value));
+            if (type == LOG_ARG_LDOUBLE) {
+                long double wide = value;
+                memcpy(out, &wide, sizeof(wide));
+                out += sizeof(wide);
+            } else {
+                memcpy(out, &value, sizeof(value));
+                out += sizeof(value);
+            }
+        } else {
+            uint64_t encoded;
+            if (!get_varint(reader, &encoded)) return false;
+            int64_t value = unzigzag(encoded);
+            memcpy(out, &value, sizeof(value));
+            out += sizeof(value);
+        }
+    }
+    return true;
+}
+
+// ==================== READER ====================
+bool logger_binary_reader_open(logger_binary_reader_t* reader, FILE* in) {
+    memset(reader, 0, sizeof(*reader));
+    reader->in = in;
+    
+    char magic[sizeof(LOGGER_BINARY_MAGIC) - 1];
+    uint8_t version;
+    if (!get_bytes(reader, magic, sizeof(magic)) ||
+        memcmp(magic, LOGGER_BINARY_MAGIC, sizeof(magic)) != 0) {
+        return false;
+    }
+    if (!get_byte(reader, &version) || version != LOGGER_BINARY_VERSION) return false;
+    
+    return get_u64le(reader, &reader->wall_base_us);
+}
+
+bool logger_binary_reader_next(logger_binary_reader_t* reader, logger_binary_record_t* record) {
+    uint8_t tag;
+    while (get_byte(reader, &tag)) {
+        if (tag == LOGGER_BINARY_TAG_FORMAT) {
+            if (!read_format(reader)) return false;
+            continue;
+        }
+        if (tag != LOGGER_BINARY_TAG_RECORD) return false;
+        
+        uint64_t id, delta;
+        if (!get_varint(reader, &id) || !get_varint(reader, &delta)) return false;
+        if (id >= reader->format_capacity || !reader->formats[id].defined) return false;
+        
+        const logger_binary_format_t* format = &reader->formats[id];
+        if (!read_args(reader, format)) return false;
+        
+        reader->timestamp_us += (uint64_t)unzigzag(delta);
+        record->format = format;
+        record->timestamp_us = reader->timestamp_us;
+        record->wall_us = reader->wall_base_us + reader->timestamp_us;
+        record->args = reader->args;
+        return true;
+    }
+    return false;
+}
+
+size_t logger_binary_render(const logger_binary_record_t* record, char* message, size_t space) {
+    const logger_binary_format_t* format = record->format;
+    return logger_format_render(format->format, format->arg_types, format->arg_count,
+                                record->args, message, space);
+}
+
+void logger_binary_reader_close(logger_binary_reader_t* reader) {
+    for (uint32_t i = 0; i < reader->format_capacity; i++) {
+        free(reader->formats[i].file);
+        free(reader->formats[i].format);
+    }
+    free(reader->formats);
+    reader->formats = NULL;
+    reader->format_capacity = 0;
+}
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include "logger_format.h"
+#include <stdio.h>
+#include <string.h>
+
+// Longest conversion spec the renderer copies, '%' and terminator included
+#define LOGGER_FORMAT_SPEC_MAX 32
+
+// ==================== PARSING ====================
+size_t logger_format_arg_size(uint8_t type) {
+    if (type == LOG_ARG_STRING) return 0;
+    return type == LOG_ARG_LDOUBLE ? sizeof(long double) : 8u;
+}
+
+// One conversion spec: the '*' arguments it takes, the type of its value,
+// and whether snprintf can be handed it with that type ('n', wide
+// characters, positional arguments and unknown conversions cannot)
+typedef struct {
+    uint8_t stars;
+    uint8_t type;
+    bool safe;
+} format_spec_t;
+
+// Scan the spec that starts after a '%'; returns where it ends, or NULL
+// if the format ends first
+static const char* format_scan(const char* p, format_spec_t* spec) {
+    spec->stars = 0;
+    
+    // Flags, then width and precision ('*' consumes an int argument)
+    while (*p && strchr("-+ #0'", *p)) p++;
+    for (int part = 0; part < 2; part++) {
+        if (*p == '*') {
+            spec->stars++;
+            p++;
+        } else {
+            while (*p >= '0' && *p <= '9') p++;
+        }
+        if (part == 0 && *p == '.') p++;
+        else break;
+    }
+    
+    // Length modifier
+    uint8_t type = LOG_ARG_INT;
+    char length = '\0';
+    if (p[0] == 'h') {
+        length = 'h';
+        p += (p[1] == 'h') ? 2 : 1;
+    } else if (p[0] == 'l' && p[1] == 'l') {
+        type = LOG_ARG_LLONG;
+        length = 'q';
+        p += 2;
+    } else if (p[0] && strchr("lzjtL", p[0])) {
+        length = p[0];
+        type = length == 'l' ? LOG_ARG_LONG : length == 'z' ? LOG_ARG_SIZE :
+               length == 'j' ? LOG_ARG_INTMAX : length == 't' ? LOG_ARG_PTRDIFF :
+               LOG_ARG_LDOUBLE;
+        p++;
+    }
+    
+    // Conversion
+    switch (*p) {
+        case 'f': case 'F': case 'e': case 'E':
+        case 'g': case 'G': case 'a': case 'A':
+            if (type != LOG_ARG_LDOUBLE) type = LOG_ARG_DOUBLE;
+            spec->safe = length == '\0' || length == 'l' || length == 'L';
+            break;
+        case 's':
+            type = LOG_ARG_STRING;
+            spec->safe = length == '\0';
+            break;
+        case 'p':
+            type = LOG_ARG_POINTER;
+            spec->safe = length == '\0';
+            break;
+        case 'c':
+            spec->safe = length == '\0';
+            break;
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+            spec->safe = length != 'L';
+            break;
+        default:
+            spec->safe = false;
+            break;
+    }
+    spec->type = type;
+    
+    return *p ? p + 1 : NULL;
+}
+
+uint8_t logger_format_parse(const char* format, uint8_t types[LOGGER_MAX_ARGS]) {
+    const char* p = format;
+    uint8_t count = 0;
+    
+    while (*p) {
+        if (*p++ != '%') continue;
+        if (*p == '%') {
+            p++;
+            continue;
+        }
+        
+        format_spec_t spec;
+        const char* end = format_scan(p, &spec);
+        for (uint8_t i = 0; i < spec.stars; i++) {
+            if (count < LOGGER_MAX_ARGS) types[count++] = LOG_ARG_INT;
+        }
+        if (!end) break;
+        
+        if (count < LOGGER_MAX_ARGS) types[count++] = spec.type;
+        p = end;
+    }
+    
+    return count;
+}
+
+bool logger_format_check(const char* format, const uint8_t* types, uint8_t count) {
+    const char* p = format;
+    uint8_t arg = 0;
+    
+    while (*p) {
+        if (*p++ != '%') continue;
+        if (*p == '%') {
+            p++;
+            continue;
+        }
+        
+        format_spec_t spec;
+        const char* end = format_scan(p, &spec);
+        if (!end || !spec.safe || end - p > LOGGER_FORMAT_SPEC_MAX - 2) return false;
+        
+        for (uint8_t i = 0; i < spec.stars; i++) {
+            if (arg >= count || types[arg++] != LOG_ARG_INT) return false;
+        }
+        if (arg >= count || types[arg++] != spec.type) return false;
+        p = end;
+    }
+    
+    return arg == count;
+}
+
+// ==================== RENDERING ====================
+// Format one conversion spec with the value read from the argument block
+static int logger_format_arg(char* dest, size_t space, const char* spec, uint8_t type,
+                             const uint8_t** in, const int* stars, int star_count) {
+    uint64_t raw = 0;
+    if (type != LOG_ARG_STRING && type != LOG_ARG_LDOUBLE) {
+        memcpy(&raw, *in, sizeof(raw));
+        *in += sizeof(raw);
+    }
+
+#define LOG_SNPRINTF(value) \
+    (star_count == 2 ? snprintf(dest, space, spec, stars[0], stars[1], value) : \
+     star_count == 1 ? snprintf(dest, space, spec, stars[0], value) : \
+                       snprintf(dest, space, spec, value))
+    
+    switch (type) {
+        case LOG_ARG_INT:     return LOG_SNPRINTF((int)(int64_t)raw);
+        case LOG_ARG_LONG:    return LOG_SNPRINTF((long)(int64_t)raw);
+        case LOG_ARG_LLONG:   return LOG_SNPRINTF((long long)raw);
+        case LOG_ARG_SIZE:    return LOG_SNPRINTF((size_t)raw);
+        case LOG_ARG_INTMAX:  return LOG_SNPRINTF((intmax_t)raw);
+        case LOG_ARG_PTRDIFF: return LOG_SNPRINTF((ptrdiff_t)raw);
+        case LOG_ARG_POINTER: return LOG_SNPRINTF((void*)(uintptr_t)raw);
+        case LOG_ARG_DOUBLE: {
+            double value;
+            memcpy(&value, &raw, sizeof(value));
+            return LOG_SNPRINTF(value);
+        }
+        case LOG_ARG_LDOUBLE: {
+            long double value;
+            memcpy(&value, *in, sizeof(value));
+            *in += sizeof(value);
+            return LOG_SNPRINTF(value);
+        }
+        case LOG_ARG_STRING: {
+            uint16_t len;
+            memcpy(&len, *in, sizeof(len));
+            if (len > LOGGER_MAX_STRING) len = LOGGER_MAX_STRING;
+            char str[LOGGER_MAX_STRING + 1];
+            memcpy(str, *in + sizeof(len), len);
+            str[len] = '\0';
+            *in += sizeof(len) + len;
+            return LOG_SNPRINTF(str);
+        }
+        default:
+            return 0;
+    }
+
+#undef LOG_SNPRINTF
+}
+
+size_t logger_format_render(const char* format, const uint8_t* types, uint8_t count,
+                            const uint8_t* args, char* message, size_t space) {
+    const char* p = format;
+    const uint8_t* in = args;
+    size_t len = 0;
+    uint8_t arg = 0;
+    
+    if (space == 0) return 0;
+    
+    while (*p && len + 1 < space) {
+        if (*p != '%') {
+            message[len++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            message[len++] = '%';
+            p += 2;
+            continue;
+        }
+        
+        // Copy one conversion spec, collecting any '*' arguments
+        char spec[LOGGER_FORMAT_SPEC_MAX];
+        size_t spec_len = 0;
+        int stars[2];
+        int star_count = 0;
+        
+        spec[spec_len++] = *p++;
+        while (*p && spec_len < sizeof(spec) - 1) {
+            char c = *p++;
+            spec[spec_len++] = c;
+            if (c == '*' && star_count < 2 && arg < count) {
+                uint64_t raw;
+                memcpy(&raw, in, sizeof(raw));
+                in += sizeof(raw);
+                stars[star_count++] = (int)(int64_t)raw;
+                arg++;
+            }
+            if (strchr("diouxXcfFeEgGaAsp", c)) break;
+        }
+        spec[spec_len] = '\0';
+        
+        if (arg >= count) break;
+        
+        int written = logger_format_arg(&message[len], space - len, spec,
+                                        types[arg++], &in, stars, star_count);
+        if (written > 0) {
+            len += (size_t)written;
+            if (len >= space) len = space - 1;
+        }
+    }
+    
+    message[len] = '\0';
+    return len;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef LOGGER_FORMAT_H
+#define LOGGER_FORMAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// printf-format handling shared by the async ring, the binary log writer
+// and the offline decoder. None of them format at the call site: they keep
+// the raw argument values and rebuild the text later from the format.
+//
+// Raw argument block, one entry per argument in format order:
+//   integers, pointers, doubles  8 bytes (integers sign-extended)
+//   long double                  sizeof(long double) bytes
+//   strings                      uint16_t length + bytes (no terminator)
+#define LOGGER_MAX_ARGS             12
+#define LOGGER_MAX_STRING           128
+
+// Longest raw argument block a single record can need
+#define LOGGER_MAX_ARGS_SIZE        (LOGGER_MAX_ARGS * (sizeof(uint16_t) + LOGGER_MAX_STRING))
+
+// How each argument was passed through the varargs
+typedef enum {
+    LOG_ARG_INT = 0,
+    LOG_ARG_LONG,
+    LOG_ARG_LLONG,
+    LOG_ARG_SIZE,
+    LOG_ARG_INTMAX,
+    LOG_ARG_PTRDIFF,
+    LOG_ARG_DOUBLE,
+    LOG_ARG_LDOUBLE,
+    LOG_ARG_STRING,
+    LOG_ARG_POINTER,
+    LOG_ARG_TYPE_COUNT
+} log_arg_type_t;
+
+// Parse a format into argument types ('*' widths count as LOG_ARG_INT);
+// returns the number of arguments, at most LOGGER_MAX_ARGS
+uint8_t logger_format_parse(const char* format, uint8_t types[LOGGER_MAX_ARGS]);
+
+// True if the format takes exactly the arguments 'types' lists and every
+// conversion can be rendered from a raw block (no %n, wide characters or
+// positional arguments). Formats from outside the program, such as those
+// in a binary log, must pass before they are rendered.
+bool logger_format_check(const char* format, const uint8_t* types, uint8_t count);
+
+// Size of an argument in the raw block (strings: 0, they vary)
+size_t logger_format_arg_size(uint8_t type);
+
+// Rebuild the message text from a format and its raw argument block
+size_t logger_format_render(const char* format, const uint8_t* types, uint8_t count,
+                            const uint8_t* args, char* message, size_t space);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "logger_sink.h"
+#include <string.h>
+
+// ==================== CONSOLE ====================
+static void console_write(log_sink_t* sink, const char* data, size_t length) {
+    log_console_sink_t* console = (log_console_sink_t*)sink;
+    fwrite(data, 1, length, console->stream);
+}
+
+static void console_flush(log_sink_t* sink) {
+    fflush(((log_console_sink_t*)sink)->stream);
+}
+
+void log_console_sink_init(log_console_sink_t* sink, FILE* stream) {
+    memset(sink, 0, sizeof(*sink));
+    sink->base.name = "console";
+    sink->base.write = console_write;
+    sink->base.flush = console_flush;
+    sink->stream = stream ? stream : stdout;
+}
+
+// ==================== FILE ====================
+// Shift path -> path.1 -> path.2 ... dropping the oldest, then reopen
+static void file_rotate(log_file_sink_t* sink) {
+    char from[LOG_FILE_SINK_PATH_MAX + 12];
+    char to[LOG_FILE_SINK_PATH_MAX + 12];
+    
+    fclose(sink->file);
+    sink->file = NULL;
+    
+    if (sink->max_files == 0) {
+        remove(sink->path);
+    } else {
+        snprintf(to, sizeof(to), "%s.%u", sink->path, sink->max_files);
+        remove(to);
+        for (uint32_t i = sink->max_files - 1; i >= 1; i--) {
+            snprintf(from, sizeof(from), "%s.%u", sink->path, i);
+            snprintf(to, sizeof(to), "%s.%u", sink->path, i + 1);
+            rename(from, to);
+        }
+        snprintf(to, sizeof(to), "%s.1", sink->path);
+        rename(sink->path, to);
+    }
+    
+    sink->file = fopen(sink->path, "wb");
+    sink->file_size = 0;
+    sink->rotations++;
+}
+
+static void file_write(log_sink_t* base, const char* data, size_t length) {
+    log_file_sink_t* sink = (log_file_sink_t*)base;
+    
+    while (length > 0 && sink->file) {
+        size_t room = sink->max_bytes > sink->file_size ? sink->max_bytes - sink->file_size : 0;
+        if (length <= room) {
+            fwrite(data, 1, length, sink->file);
+            sink->file_size += length;
+            return;
+        }
+        
+        // Finish this file with the whole lines that still fit
+        size_t chunk = 0;
+        for (size_t i = room; i > 0; i--) {
+            if (data[i - 1] == '\n') {
+                chunk = i;
+                break;
+            }
+        }
+        
+        // A single line longer than the limit gets a file of its own
+        if (chunk == 0 && sink->file_size == 0) {
+            const char* newline = memchr(data, '\n', length);
+            chunk = newline ? (size_t)(newline - data) + 1 : length;
+        }
+        
+        fwrite(data, 1, chunk, sink->file);
+        sink->file_size += chunk;
+        data += chunk;
+        length -= chunk;
+        
+        file_rotate(sink);
+    }
+}
+
+static void file_flush(log_sink_t* base) {
+    log_file_sink_t* sink = (log_file_sink_t*)base;
+    if (sink->file) fflush(sink->file);
+}
+
+bool log_file_sink_open(log_file_sink_t* sink, const char* path,
+                        size_t max_bytes, uint32_t max_files) {
+    memset(sink, 0, sizeof(*sink));
+    
+    if (!path || strlen(path) >= LOG_FILE_SINK_PATH_MAX || max_bytes == 0) {
+        printf("[LOGGER] Error: Invalid log file parameters\n");
+        return false;
+    }
+    
+    sink->file = fopen(path, "wb");
+    if (!sink->file) {
+        printf("[LOGGER] Error: Cannot open log file %s\n", path);
+        return false;
+    }
+    
+    strcpy(sink->path, path);
+    sink->max_bytes = max_bytes;
+    sink->max_files = max_files;
+    sink->base.name = "file";
+    sink->base.write = file_write;
+    sink->base.flush = file_flush;
+    
+    printf("[LOGGER] Log file %s (rotate at %zu bytes, keep %u)\n", path, max_bytes, max_files);
+    return true;
+}
+
+void log_file_sink_close(log_file_sink_t* sink) {
+    if (sink->file) {
+        fclose(sink->file);
+        sink->file = NULL;
+    }
+}
+
+// ==================== RING MEMORY ====================
+static void ring_write(log_sink_t* base, const char* data, size_t length) {
+    log_ring_sink_t* sink = (log_ring_sink_t*)base;
+    circular_buffer_write(&sink->ring, (const uint8_t*)data, length);
+}
+
+bool log_ring_sink_init(log_ring_sink_t* sink, size_t capacity) {
+    memset(sink, 0, sizeof(*sink));
+    
+    if (!circular_buffer_init(&sink->ring, capacity, true)) {
+        return false;
+    }
+    
+    sink->base.name = "ring";
+    sink->base.write = ring_write;
+    sink->base.flush = NULL;
+    return true;
+}
+
+void log_ring_sink_destroy(log_ring_sink_t* sink) {
+    circular_buffer_destroy(&sink->ring);
+}
+
+size_t log_ring_sink_snapshot(const log_ring_sink_t* sink, char* dest, size_t size) {
+    if (size == 0) return 0;
+    
+    size_t copied = circular_buffer_peek(&sink->ring, (uint8_t*)dest, size - 1, 0);
+    dest[copied] = '\0';
+    
+    // Once the ring has wrapped, the oldest line is usually cut; drop it
+    if (sink->base.bytes_written > sink->ring.capacity) {
+        char* first = memchr(dest, '\n', copied);
+        if (first) {
+            size_t skip = (size_t)(first + 1 - dest);
+            memmove(dest, first + 1, copied - skip + 1);
+            copied -= skip;
+        }
+    }
+    
+    return copied;
+}
\ No newline at end of file
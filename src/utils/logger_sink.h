@@ -0,0 +1,70 @@
+#ifndef LOGGER_SINK_H
+#define LOGGER_SINK_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "circular_buffer.h"
+
+// Log sink: a destination for formatted log text. The logger batches lines
+// in one shared write buffer and hands each batch to every registered sink,
+// so a sink sees whole lines, in order, a few kilobytes at a time.
+typedef struct log_sink log_sink_t;
+
+struct log_sink {
+    const char* name;
+    void (*write)(log_sink_t* sink, const char* data, size_t length);
+    void (*flush)(log_sink_t* sink);            // Optional
+    uint64_t bytes_written;
+    uint32_t write_calls;
+};
+
+// Console (or any already-open stream)
+typedef struct {
+    log_sink_t base;
+    FILE* stream;
+} log_console_sink_t;
+
+// File with size-based rotation: when the file would grow past max_bytes
+// it becomes path.1 (path.1 becomes path.2, ...) and a fresh file is
+// started. At most max_files rotated files are kept; the oldest is deleted.
+#define LOG_FILE_SINK_PATH_MAX 128
+
+typedef struct {
+    log_sink_t base;
+    FILE* file;
+    char path[LOG_FILE_SINK_PATH_MAX];
+    size_t max_bytes;
+    uint32_t max_files;
+    size_t file_size;
+    uint32_t rotations;
+} log_file_sink_t;
+
+// Memory ring keeping the most recent output (oldest bytes are overwritten)
+typedef struct {
+    log_sink_t base;
+    circular_buffer_t ring;
+} log_ring_sink_t;
+
+// Initialize a console sink writing to 'stream' (stdout if NULL)
+void log_console_sink_init(log_console_sink_t* sink, FILE* stream);
+
+// Open (truncate) a rotating file sink
+bool log_file_sink_open(log_file_sink_t* sink, const char* path,
+                        size_t max_bytes, uint32_t max_files);
+
+// Close a file sink
+void log_file_sink_close(log_file_sink_t* sink);
+
+// Initialize a ring-memory sink holding the last 'capacity' bytes
+bool log_ring_sink_init(log_ring_sink_t* sink, size_t capacity);
+
+// Destroy a ring-memory sink
+void log_ring_sink_destroy(log_ring_sink_t* sink);
+
+// Copy the ring contents (oldest first) without consuming them; returns
+// the number of bytes copied, 'dest' is NUL-terminated
+size_t log_ring_sink_snapshot(const log_ring_sink_t* sink, char* dest, size_t size);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "trace.h"
+#include "logger.h"
+#include "flight_recorder.h"
+#include <string.h>
+
+atomic_uint trace_enabled_mask = 0;
+
+static trace_record_t trace_ring[TRACE_RING_SIZE];
+static atomic_uint trace_head = 0;     // Records ever claimed
+
+// ==================== CONTROL ====================
+void trace_enable(uint32_t categories) {
+    atomic_fetch_or_explicit(&trace_enabled_mask, categories, memory_order_relaxed);
+}
+
+void trace_disable(uint32_t categories) {
+    atomic_fetch_and_explicit(&trace_enabled_mask, ~categories, memory_order_relaxed);
+}
+
+uint32_t trace_recorded(void) {
+    return atomic_load_explicit(&trace_head, memory_order_acquire);
+}
+
+void trace_clear(void) {
+    for (uint32_t i = 0; i < TRACE_RING_SIZE; i++) {
+        atomic_store_explicit(&trace_ring[i].sequence, 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&trace_head, 0, memory_order_release);
+}
+
+const char* trace_category_to_string(uint32_t category) {
+    switch (category) {
+        case TRACE_CAT_KERNEL:   return "KERNEL";
+        case TRACE_CAT_HAL:      return "HAL";
+        case TRACE_CAT_IRQ:      return "IRQ";
+        case TRACE_CAT_PROTOCOL: return "PROTOCOL";
+        case TRACE_CAT_FLASH:    return "FLASH";
+        default: return "UNKNOWN";
+    }
+}
+
+// ==================== RECORDING ====================
+void trace_write(const trace_point_t* point, const uint32_t* args) {
+    // Claiming a slot is the only shared write; the oldest record is overwritten
+    uint32_t index = atomic_fetch_add_explicit(&trace_head, 1, memory_order_relaxed);
+    trace_record_t* record = &trace_ring[index & (TRACE_RING_SIZE - 1)];
+    
+    atomic_store_explicit(&record->sequence, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    
+    record->point = point;
+    record->timestamp_us = logger_timestamp_us();
+    memcpy(record->args, args, sizeof(record->args));
+    flight_recorder_trace(record);
+    
+    atomic_store_explicit(&record->sequence, index + 1, memory_order_release);
+}
+
+bool trace_read(uint32_t index, trace_record_t* record) {
+    const trace_record_t* slot = &trace_ring[index & (TRACE_RING_SIZE - 1)];
+    
+    if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != index + 1) {
+        return false;
+    }
+    
+    record->point = slot->point;
+    record->timestamp_us = slot->timestamp_us;
+    memcpy(record->args, slot->args, sizeof(record->args));
+    
+    // A writer that lapped the ring meanwhile changed the sequence first
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&slot->sequence, memory_order_relaxed) == index + 1;
+}
+
+// ==================== OUTPUT ====================
+size_t trace_render(const trace_record_t* record, char* text, size_t space) {
+    const uint32_t* a = record->args;
+    int len = snprintf(text, space, "[%6u.%06u] [%-8s] ",
+                       (unsigned)(record->timestamp_us / 1000000u),
+                       (unsigned)(record->timestamp_us % 1000000u),
+                       trace_category_to_string(record->point->category));
+    if (len < 0 || (size_t)len >= space) return space ? space - 1 : 0;
+    
+    int message = snprintf(text + len, space - len, record->point->format,
+                           (unsigned)a[0], (unsigned)a[1], (unsigned)a[2], (unsigned)a[3]);
+    if (message < 0) return (size_t)len;
+    
+    size_t total = (size_t)len + (size_t)message;
+    return total < space ? total : space - 1;
+}
+
+void trace_dump(FILE* out, uint32_t categories) {
+    uint32_t head = trace_recorded();
+    uint32_t first = head > TRACE_RING_SIZE ? head - TRACE_RING_SIZE : 0;
+    uint32_t lost = 0;
+    char text[256];
+    
+    fprintf(out, "[TRACE] %u records (%u kept)\n", head, head - first);
+    
+    for (uint32_t i = first; i != head; i++) {
+        trace_record_t record;
+        if (!trace_read(i, &record)) {
+            lost++;
+            continue;
+        }
+        if (!(record.point->category & categories)) continue;
+        
+        size_t len = trace_render(&record, text, sizeof(text) - 1);
+        text[len++] = '\n';
+        fwrite(text, 1, len, out);
+    }
+    
+    if (lost > 0) {
+        fprintf(out, "[TRACE] %u records overwritten while dumping\n", lost);
+    }
+    fflush(out);
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+// Trace points for hot paths. A TRACE() call stores a fixed-size binary
+// record (point, timestamp, up to four 32-bit arguments) in one lock-free
+// ring; nothing is formatted until the ring is dumped.
+
+// Categories (bit mask)
+#define TRACE_CAT_KERNEL        (1u << 0)
+#define TRACE_CAT_HAL           (1u << 1)
+#define TRACE_CAT_IRQ           (1u << 2)
+#define TRACE_CAT_PROTOCOL      (1u << 3)
+#define TRACE_CAT_FLASH         (1u << 4)
+#define TRACE_CAT_COUNT         5
+#define TRACE_CAT_ALL           0xFFFFFFFFu
+
+// Categories compiled in; TRACE() calls outside this mask compile to
+// nothing, arguments included. Release builds can set it to 0.
+#ifndef TRACE_COMPILE_MASK
+#define TRACE_COMPILE_MASK      TRACE_CAT_ALL
+#endif
+
+#define TRACE_MAX_ARGS          4
+#define TRACE_RING_SIZE         1024    // Records kept, power of two
+
+// Static description of one TRACE() call site
+typedef struct {
+    const char* format;                 // printf format, unsigned int arguments
+    uint32_t category;
+} trace_point_t;
+
+// One ring entry
+typedef struct {
+    atomic_uint sequence;               // Record index + 1 once written, 0 while writing
+    const trace_point_t* point;
+    uint64_t timestamp_us;              // logger_timestamp_us() clock
+    uint32_t args[TRACE_MAX_ARGS];
+} trace_record_t;
+
+// Categories recording at runtime (default none). Updated by
+// trace_enable() / trace_disable(); read-only here.
+extern atomic_uint trace_enabled_mask;
+
+// Start / stop recording categories
+void trace_enable(uint32_t categories);
+void trace_disable(uint32_t categories);
+
+// Total records written since the last clear (older ones are overwritten)
+uint32_t trace_recorded(void);
+
+// Drop everything recorded (not while other threads are tracing)
+void trace_clear(void);
+
+// Copy record number 'index' (0 = first since the last clear); false if
+// it has been overwritten or is still being written
+bool trace_read(uint32_t index, trace_record_t* record);
+
+// Format a record as "[seconds.micros] [CATEGORY] message"
+size_t trace_render(const trace_record_t* record, char* text, size_t space);
+
+// Write the recorded entries of 'categories', oldest first
+void trace_dump(FILE* out, uint32_t categories);
+
+const char* trace_category_to_string(uint32_t category);
+
+// Record a trace point with up to TRACE_MAX_ARGS integer arguments
+// (the format must be a string literal)
+#define TRACE(cat, fmt, ...) do { \
+        if (((cat) & TRACE_COMPILE_MASK) && \
+            (atomic_load_explicit(&trace_enabled_mask, memory_order_relaxed) & (cat))) { \
+            static const trace_point_t trace_point_ = { .format = (fmt), .category = (cat) }; \
+            const uint32_t trace_args_[TRACE_MAX_ARGS + 1] = { 0, ##__VA_ARGS__ }; \
+            trace_write(&trace_point_, trace_args_ + 1); \
+        } \
+    } while (0)
+
+// Internal: used by TRACE()
+void trace_write(const trace_point_t* point, const uint32_t* args);
+
+#endif
\ No newline at end of file
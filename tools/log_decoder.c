@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../src/utils/logger_binary.h"
+
+// Host tool: decode, filter and grep binary log files written by
+// logger_binary_start(). Output matches the logger's text lines.
+
+static const char* level_names[] = { "DEBUG", "INFO", "WARN", "ERROR", "FATAL" };
+static const char* module_names[] = { "KERNEL", "HAL", "PROTOCOL", "OTA", "APP" };
+
+#define LEVEL_COUNT  (int)(sizeof(level_names) / sizeof(level_names[0]))
+#define MODULE_COUNT (int)(sizeof(module_names) / sizeof(module_names[0]))
+
+typedef struct {
+    int min_level;
+    int module;                 // -1 = all
+    const char* grep;
+    bool count_only;
+    bool show_source;
+} decoder_options_t;
+
+static logger_binary_reader_t reader;
+
+static int lookup(const char* name, const char** names, int count) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(name, names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+static void print_usage(const char* program) {
+    printf("Usage: %s [options] file...\n", program);
+    printf("  -l LEVEL   Only records at LEVEL or above (DEBUG INFO WARN ERROR FATAL)\n");
+    printf("  -m MODULE  Only records from MODULE (KERNEL HAL PROTOCOL OTA APP)\n");
+    printf("  -g TEXT    Only records whose message contains TEXT\n");
+    printf("  -s         Show source file and line\n");
+    printf("  -c         Print the number of matching records only\n");
+}
+
+static void print_record(const logger_binary_record_t* record, const char* message,
+                         const decoder_options_t* options) {
+    const logger_binary_format_t* format = record->format;
+    time_t seconds = (time_t)(record->wall_us / 1000000u);
+    struct tm* timeinfo = localtime(&seconds);
+    char date[32];
+    strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", timeinfo);
+    
+    const char* level = format->level < LEVEL_COUNT ? level_names[format->level] : "?";
+    const char* module = format->module < MODULE_COUNT ? module_names[format->module] : "?";
+    
+    if (options->show_source) {
+        const char* file = strrchr(format->file, '/');
+        file = file ? file + 1 : format->file;
+        printf("[%s.%06u] [%5s] %-8s (%s:%u) %s\n", date, (unsigned)(record->wall_us % 1000000u),
+               level, module, file, (unsigned)format->line, message);
+    } else {
+        printf("[%s.%06u] [%5s] %-8s %s\n", date, (unsigned)(record->wall_us % 1000000u),
+               level, module, message);
+    }
+}
+
+// Decode one file; returns the number of matching records, or -1 on error
+static long decode_file(const char* path, const decoder_options_t* options) {
+    FILE* in = fopen(path, "rb");
+    if (!in) {
+        fprintf(stderr, "%s: cannot open\n", path);
+        return -1;
+    }
+    
+    if (!logger_binary_reader_open(&reader, in)) {
+        fprintf(stderr, "%s: not a binary log (or unsupported version)\n", path);
+        fclose(in);
+        return -1;
+    }
+    
+    long matched = 0;
+    logger_binary_record_t record;
+    char message[1024];
+    
+    while (logger_binary_reader_next(&reader, &record)) {
+        const logger_binary_format_t* format = record.format;
+        
+        // Cheap filters first: no formatting for records that are skipped
+        if (format->level < options->min_level) continue;
+        if (options->module >= 0 && format->module != options->module) continue;
+        if (options->count_only && !options->grep) {
+            matched++;
+            continue;
+        }
+        
+        logger_binary_render(&record, message, sizeof(message));
+        if (options->grep && !strstr(message, options->grep)) continue;
+        
+        matched++;
+        if (!options->count_only) print_record(&record, message, options);
+    }
+    
+    if (!feof(in)) {
+        fprintf(stderr, "%s: corrupt data, stopped early\n", path);
+    }
+    
+    logger_binary_reader_close(&reader);
+    fclose(in);
+    return matched;
+}
+
+int main(int argc, char* argv[]) {
+    decoder_options_t options = { 0, -1, NULL, false, false };
+    int first_file = argc;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+            options.min_level = lookup(argv[++i], level_names, LEVEL_COUNT);
+            if (options.min_level < 0) {
+                fprintf(stderr, "Unknown level: %s\n", argv[i]);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            options.module = lookup(argv[++i], module_names, MODULE_COUNT);
+            if (options.module < 0) {
+                fprintf(stderr, "Unknown module: %s\n", argv[i]);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+            options.grep = argv[++i];
+        } else if (strcmp(argv[i], "-s") == 0) {
+            options.show_source = true;
+        } else if (strcmp(argv[i], "-c") == 0) {
+            options.count_only = true;
+        } else if (argv[i][0] == '-') {
+            print_usage(argv[0]);
+            return 2;
+        } else {
+            first_file = i;
+            break;
+        }
+    }
+    
+    if (first_file >= argc) {
+        print_usage(argv[0]);
+        return 2;
+    }
+    
+    long total = 0;
+    bool failed = false;
+    for (int i = first_file; i < argc; i++) {
+        long matched = decode_file(argv[i], &options);
+        if (matched < 0) {
+            failed = true;
+            continue;
+        }
+        total += matched;
+    }
+    
+    if (options.count_only) {
+        printf("%ld\n", total);
+    }
+    
+    // Like grep: 0 = matches found, 1 = none, 2 = error
+    if (failed) return 2;
+    return total > 0 ? 0 : 1;
+}
\ No newline at end of file